@@ -9,6 +9,9 @@
 #include <Wire.h>
 #include <SPI.h>
 #include <Preferences.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <esp_timer.h>
 
 // Sensor libraries
 #include <Adafruit_PN532.h>
@@ -17,6 +20,11 @@
 
 // ======================== CONFIGURATION ========================
 
+// Link to the central: 0 = WebSocket over the softAP, 1 = ESP-NOW
+#ifndef BLOCK_USE_ESPNOW
+#define BLOCK_USE_ESPNOW 0
+#endif
+
 // Hardware pin assignments
 #ifndef WIFI_STATUS_LED
 #define WIFI_STATUS_LED 2
@@ -43,15 +51,22 @@ const char* WIFI_PASS = "craft123";
 const char* WS_HOST = "192.168.4.1";
 const uint16_t WS_PORT = 80;
 const char* WS_PATH = "/ws";
+const uint8_t WIFI_CHANNEL = 6;           // Must match the central's AP_CHANNEL for ESP-NOW
+const IPAddress WIFI_GATEWAY(192, 168, 4, 1);
+const IPAddress WIFI_SUBNET(255, 255, 255, 0);
 
 // Timing constants (milliseconds)
-const uint32_t SYNC_PERIOD_MS = 2000;     // Status sync interval
 const uint32_t DEBOUNCE_MS = 50;          // Button debounce time
 const uint32_t SHAKE_DEBOUNCE_MS = 500;   // Shake detection debounce
 const uint32_t RFID_TIMEOUT_MS = 50;      // RFID read timeout
 const uint32_t RFID_DEBOUNCE_MS = 1000;   // RFID detection debounce
-const uint32_t WIFI_TIMEOUT_MS = 8000;    // WiFi connection timeout
+const uint32_t WIFI_TIMEOUT_MS = 8000;    // WiFi connection timeout with a full scan
+const uint32_t WIFI_FAST_TIMEOUT_MS = 1500; // WiFi connection timeout using the cached BSSID/channel
+const uint32_t WS_RECONNECT_MS = 500;     // WebSocket retry interval while WiFi is up
+const uint32_t WIFI_LEASE_VERIFY_MS = 3000; // Time for the WebSocket to come up on a reused lease before falling back to DHCP
 const float SHAKE_THRESHOLD = 0.4;        // Shake detection sensitivity
+const uint32_t ESPNOW_HELLO_MS = 500;     // Hello broadcast interval while looking for the central
+const uint32_t ESPNOW_LINK_TIMEOUT_MS = 3000; // Central silence before the link is considered down
 
 // ======================== GLOBAL INSTANCES ========================
 
@@ -84,18 +99,19 @@ State currentState = State::BOOT;
 // Current round information
 String currentCmd = "";
 int currentRound = 0;
-int64_t roundStartServerMs = 0;   // When round officially starts (server time)
-int64_t deadlineServerMs = 0;     // Round deadline (server time)
-int64_t serverOffsetMs = 0;       // Time sync offset: serverTime - localTime
-uint32_t gameTimeMs = 2000;       // Time allowed for player action
+int64_t roundStartServerUs = 0;   // When round officially starts (server time, microseconds)
+int64_t deadlineServerUs = 0;     // Round deadline (server time, microseconds)
+int64_t serverOffsetUs = 0;       // Time sync offset: serverTime - localTime
+int64_t actionServerUs = 0;       // When the action was detected (server time)
 
 // Action tracking
 bool actionDone = false;
 bool timeExpired = false;         // Set by timer interrupt
 bool roundStarted = false;        // Whether round has begun
 
-// Timing variables
-uint32_t lastSyncStatusMs = 0;
+// Connection timing
+bool everRegistered = false;      // False until the first registration after boot
+uint32_t linkDownMs = 0;          // When the link last dropped
 
 // ======================== TIMER MANAGEMENT ========================
 
@@ -105,14 +121,14 @@ void IRAM_ATTR onRoundTimeout() {
   timeExpired = true;
 }
 
-void startRoundTimer(uint32_t timeoutMs) {
+void startRoundTimer(uint64_t timeoutUs) {
   if (roundTimer) {
     timerEnd(roundTimer);
   }
   timeExpired = false;
   roundTimer = timerBegin(1000000); // 1MHz frequency
   timerAttachInterrupt(roundTimer, &onRoundTimeout);
-  timerAlarm(roundTimer, timeoutMs * 1000, false, 0); // Convert to microseconds
+  timerAlarm(roundTimer, max(timeoutUs, (uint64_t)1), false, 0);
 }
 
 void stopRoundTimer() {
@@ -241,19 +257,166 @@ void speakCommand(const String& cmd) {
 
 // ======================== TIME SYNCHRONIZATION ========================
 
-int64_t nowServerMs() {
-  return (int64_t)millis() + serverOffsetMs;
+// Server time in microseconds; both sides use the 64-bit esp_timer clock, which doesn't wrap
+int64_t nowServerUs() {
+  return esp_timer_get_time() + serverOffsetUs;
+}
+
+void updateServerOffset(int64_t serverTimeUs) {
+  serverOffsetUs = serverTimeUs - esp_timer_get_time();
+}
+
+// ======================== LINK LAYER ========================
+// The game protocol is the same JSON over either link; only delivery differs.
+
+void onLinkConnected();
+void onLinkDisconnected();
+void handleWsMessage(const String& payload);
+void sendHello();
+void connectWiFi();
+void serviceWiFi();
+
+#if BLOCK_USE_ESPNOW
+
+struct EspNowFrame {
+  uint8_t mac[6];
+  uint8_t len;
+  uint8_t data[ESP_NOW_MAX_DATA_LEN];
+};
+
+const uint8_t BROADCAST_MAC[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+QueueHandle_t espNowRxQueue = nullptr;
+uint8_t centralMac[6];
+bool centralKnown = false;
+bool linkUp = false;
+uint32_t lastCentralFrameMs = 0;
+uint32_t lastHelloMs = 0;
+
+void onEspNowReceive(const esp_now_recv_info* info, const uint8_t* data, int len) {
+  // Runs in the WiFi task: copy and hand off to loop()
+  if (!info || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return;
+  EspNowFrame frame;
+  memcpy(frame.mac, info->src_addr, 6);
+  frame.len = (uint8_t)len;
+  memcpy(frame.data, data, len);
+  xQueueSend(espNowRxQueue, &frame, 0);
+}
+
+bool addEspNowPeer(const uint8_t* mac) {
+  if (esp_now_is_peer_exist(mac)) return true;
+  esp_now_peer_info_t peer = {};
+  memcpy(peer.peer_addr, mac, 6);
+  peer.channel = WIFI_CHANNEL;
+  peer.ifidx = WIFI_IF_STA;
+  peer.encrypt = false;
+  return esp_now_add_peer(&peer) == ESP_OK;
+}
+
+void linkBegin() {
+  WiFi.mode(WIFI_STA);
+  // Tune to the central's channel without associating
+  esp_wifi_set_promiscuous(true);
+  esp_wifi_set_channel(WIFI_CHANNEL, WIFI_SECOND_CHAN_NONE);
+  esp_wifi_set_promiscuous(false);
+
+  espNowRxQueue = xQueueCreate(8, sizeof(EspNowFrame));
+  if (esp_now_init() != ESP_OK) {
+    Serial.println("Error initializing ESP-NOW");
+    return;
+  }
+  esp_now_register_recv_cb(onEspNowReceive);
+  addEspNowPeer(BROADCAST_MAC);
+}
+
+bool linkConnected() {
+  return linkUp;
+}
+
+void linkSend(const String& message) {
+  // Until the central answers, hellos are broadcast so it can find us
+  const uint8_t* dest = centralKnown ? centralMac : BROADCAST_MAC;
+  esp_now_send(dest, (const uint8_t*)message.c_str(), message.length());
+}
+
+// Only the central sends time syncs; other blocks' hello broadcasts arrive on the same channel
+bool isCentralSync(const EspNowFrame& frame) {
+  JSONVar doc = JSON.parse(String((char*)frame.data, frame.len));
+  return JSON.typeof(doc) != "undefined" && doc.hasOwnProperty("type") &&
+         String((const char*)doc["type"]) == "sync";
+}
+
+void linkLoop() {
+  EspNowFrame frame;
+  while (espNowRxQueue && xQueueReceive(espNowRxQueue, &frame, 0) == pdTRUE) {
+    if (centralKnown) {
+      if (memcmp(frame.mac, centralMac, 6) != 0) {
+        continue; // Another block, not the central
+      }
+    } else {
+      // Learn the central from its answer to our hello, never from whoever spoke first
+      if (!isCentralSync(frame)) {
+        continue;
+      }
+      memcpy(centralMac, frame.mac, 6);
+      centralKnown = addEspNowPeer(centralMac);
+      if (!centralKnown) {
+        continue;
+      }
+    }
+    lastCentralFrameMs = millis();
+    if (!linkUp) {
+      linkUp = true;
+      onLinkConnected();
+    }
+    handleWsMessage(String((char*)frame.data, frame.len));
+  }
+
+  if (linkUp && millis() - lastCentralFrameMs > ESPNOW_LINK_TIMEOUT_MS) {
+    // Forget the central and go back to broadcasting hellos until it answers again
+    linkUp = false;
+    esp_now_del_peer(centralMac);
+    centralKnown = false;
+    onLinkDisconnected();
+  }
+
+  // Keep announcing ourselves until the central talks back
+  if (!linkUp && millis() - lastHelloMs > ESPNOW_HELLO_MS) {
+    lastHelloMs = millis();
+    sendHello();
+  }
+}
+
+#else
+
+void wsEvent(WStype_t type, uint8_t* payload, size_t len);
+
+void linkBegin() {
+  // The WebSocket is opened as soon as WiFi reports an IP (see serviceWiFi)
+  ws.onEvent([](WStype_t t, uint8_t* p, size_t l){ wsEvent(t,p,l); });
+  ws.setReconnectInterval(WS_RECONNECT_MS);
+  connectWiFi();
+}
+
+bool linkConnected() {
+  return ws.isConnected();
 }
 
-void updateServerOffset(int64_t serverTimeMs) {
-  serverOffsetMs = serverTimeMs - (int64_t)millis();
+void linkSend(const String& message) {
+  ws.sendTXT(message.c_str(), message.length());
 }
 
-// ======================== WEBSOCKET COMMUNICATION ========================
+void linkLoop() {
+  serviceWiFi();
+  ws.loop();
+}
+
+#endif
+
+// ======================== MESSAGE COMMUNICATION ========================
 
 void wsSendJson(const JSONVar& doc) {
   String message = JSON.stringify(doc);
-  ws.sendTXT(message);
+  linkSend(message);
 }
 
 void sendHello() {
@@ -263,9 +426,9 @@ void sendHello() {
   wsSendJson(doc);
 }
 
-void sendStatus() {
+void sendPong() {
   JSONVar doc;
-  doc["type"] = "status";
+  doc["type"] = "pong";
   doc["blockId"] = BLOCK_ID;
   wsSendJson(doc);
 }
@@ -276,6 +439,9 @@ void sendResult() {
   doc["blockId"] = BLOCK_ID;
   doc["round"] = currentRound;
   doc["actionDone"] = actionDone;
+  if (actionDone) {
+    doc["actionUs"] = (double)actionServerUs;
+  }
   wsSendJson(doc);
 }
 
@@ -290,25 +456,24 @@ void handleRoundMessage(JSONVar& doc) {
   currentCmd = doc.hasOwnProperty("cmd") ? (const char*)doc["cmd"] : "";
   Serial.print("Handle round message: ");
   Serial.println(currentCmd);
-  roundStartServerMs = doc.hasOwnProperty("roundStartMs") ? (int64_t)(unsigned long)doc["roundStartMs"] : 0;
-  deadlineServerMs = doc.hasOwnProperty("deadlineMs") ? (int64_t)(unsigned long)doc["deadlineMs"] : 0;
-  gameTimeMs = doc.hasOwnProperty("gameTimeMs") ? (int)doc["gameTimeMs"] : 2000;
+  roundStartServerUs = doc.hasOwnProperty("roundStartUs") ? (int64_t)(double)doc["roundStartUs"] : 0;
+  deadlineServerUs = doc.hasOwnProperty("deadlineUs") ? (int64_t)(double)doc["deadlineUs"] : 0;
   
   // Reset round state
   actionDone = false;
   roundStarted = false;
 
-  int64_t currentServerTime = nowServerMs();
+  int64_t currentServerTime = nowServerUs();
   
   // Check if round has already expired
-  if (currentServerTime >= deadlineServerMs) {
+  if (currentServerTime >= deadlineServerUs) {
     sendResult();
     currentState = State::REPORTED;
     return;
   }
 
   // Check if round should start immediately
-  if (currentServerTime >= roundStartServerMs) {
+  if (currentServerTime >= roundStartServerUs) {
     startRoundNow();
   } else {
     currentState = State::WAIT_ROUND;
@@ -320,7 +485,9 @@ void startRoundNow() {
   digitalWrite(PIN_LED_RED, LOW); // Clear previous feedback
   digitalWrite(PIN_LED_GREEN, LOW); // Clear previous feedback
   roundStarted = true;
-  startRoundTimer(gameTimeMs);
+  // Time out at the server's deadline rather than a full window from now, so a late start isn't rewarded
+  int64_t remainingUs = deadlineServerUs - nowServerUs();
+  startRoundTimer(remainingUs > 0 ? (uint64_t)remainingUs : 0);
   speakCommand(currentCmd);
   currentState = State::EXECUTING;
 }
@@ -334,8 +501,11 @@ void handleWsMessage(const String& payload) {
   String msgType = doc.hasOwnProperty("type") ? (const char*)doc["type"] : "";
   
   if (msgType == "sync") {
-    int64_t serverTime = doc.hasOwnProperty("serverTimeMs") ? (int64_t)(unsigned long)doc["serverTimeMs"] : 0;
+    int64_t serverTime = doc.hasOwnProperty("serverTimeUs") ? (int64_t)(double)doc["serverTimeUs"] : 0;
     updateServerOffset(serverTime);
+  } else if (msgType == "ping") {
+    // Liveness check over links without control frames (ESP-NOW)
+    sendPong();
   } else if (msgType == "round") {
     handleRoundMessage(doc);
   } else if (msgType == "control") {
@@ -346,21 +516,41 @@ void handleWsMessage(const String& payload) {
   // Unknown message types are silently ignored
 }
 
+void onLinkConnected() {
+  digitalWrite(PIN_ONBOARD_LED_BLUE, HIGH);
+  digitalWrite(PIN_LED_BLUE, HIGH);
+  sendHello();
+  currentState = State::REGISTERED;
+
+  // Report how long it took to (re)join the game
+  if (!everRegistered) {
+    everRegistered = true;
+    Serial.printf("Registered %lu ms after boot\n", (unsigned long)millis());
+  } else {
+    Serial.printf("Re-registered %lu ms after drop\n", (unsigned long)(millis() - linkDownMs));
+  }
+}
+
+void onLinkDisconnected() {
+  if (currentState != State::NET_CONNECT) {
+    linkDownMs = millis(); // Failed reconnect attempts don't restart the clock
+  }
+  digitalWrite(PIN_ONBOARD_LED_BLUE, LOW);
+  digitalWrite(PIN_LED_BLUE, LOW);
+  stopRoundTimer();
+  roundStarted = false;
+  currentState = State::NET_CONNECT;
+}
+
+#if !BLOCK_USE_ESPNOW
 void wsEvent(WStype_t type, uint8_t* payload, size_t len) {
   switch (type) {
     case WStype_CONNECTED:
-      digitalWrite(PIN_ONBOARD_LED_BLUE, HIGH);
-      digitalWrite(PIN_LED_BLUE, HIGH);
-      sendHello();
-      currentState = State::REGISTERED;
+      onLinkConnected();
       break;
       
     case WStype_DISCONNECTED:
-      digitalWrite(PIN_ONBOARD_LED_BLUE, LOW);
-      digitalWrite(PIN_LED_BLUE, LOW);
-      stopRoundTimer();
-      roundStarted = false;
-      currentState = State::NET_CONNECT;
+      onLinkDisconnected();
       break;
       
     case WStype_TEXT:
@@ -372,26 +562,179 @@ void wsEvent(WStype_t type, uint8_t* payload, size_t len) {
       break;
   }
 }
+#endif
 
 // ======================== NETWORK MANAGEMENT ========================
 
+// AP parameters cached in NVS so reconnects skip the channel scan
+uint8_t cachedBssid[6];
+uint8_t cachedChannel = 0;        // 0 = nothing cached
+
+// Last DHCP lease, reused after a reset so the block doesn't wait on DHCP. The central's DHCP
+// server keeps the lease for our MAC, so nobody else is handed it while the central stays up.
+uint32_t cachedIp = 0;            // 0 = nothing cached
+bool usingCachedIp = false;
+bool leaseVerified = false;
+uint32_t wifiUpMs = 0;
+
+// Connection progress (flags are set from the WiFi event task)
+volatile bool wifiGotIp = false;
+volatile bool wifiLost = false;
+bool wifiConnecting = false;
+uint32_t wifiAttemptMs = 0;
+bool attemptUsedApCache = false; // this attempt skipped the scan
+bool scanNextAttempt = false;    // a cached attempt failed: scan once, but keep the cache
+
+void loadApCache() {
+  prefs.begin("block", true);
+  if (prefs.getBytes("bssid", cachedBssid, sizeof(cachedBssid)) == sizeof(cachedBssid)) {
+    cachedChannel = prefs.getUChar("channel", 0);
+  }
+  cachedIp = prefs.getUInt("ip", 0);
+  prefs.end();
+}
+
+void saveApCache() {
+  uint8_t* bssid = WiFi.BSSID();
+  uint8_t channel = (uint8_t)WiFi.channel();
+  if (!bssid || (channel == cachedChannel && memcmp(bssid, cachedBssid, 6) == 0)) {
+    return; // Unchanged, don't wear the flash
+  }
+
+  memcpy(cachedBssid, bssid, 6);
+  cachedChannel = channel;
+  prefs.begin("block");
+  prefs.putBytes("bssid", cachedBssid, sizeof(cachedBssid));
+  prefs.putUChar("channel", cachedChannel);
+  prefs.end();
+}
+
+void saveLease() {
+  uint32_t ip = (uint32_t)WiFi.localIP();
+  if (ip == 0 || ip == cachedIp) {
+    return;
+  }
+  cachedIp = ip;
+  prefs.begin("block");
+  prefs.putUInt("ip", cachedIp);
+  prefs.end();
+}
+
+void forgetLease() {
+  if (cachedIp == 0) {
+    return;
+  }
+  cachedIp = 0;
+  prefs.begin("block");
+  prefs.remove("ip");
+  prefs.end();
+}
+
+void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    wifiGotIp = true;
+  } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    // Our own WiFi.disconnect() before a retry is not a lost link
+    if (info.wifi_sta_disconnected.reason != WIFI_REASON_ASSOC_LEAVE) {
+      wifiLost = true;
+    }
+  }
+}
+
+/**
+ * Start a connection attempt without waiting for it; serviceWiFi() follows it up.
+ * With a cached BSSID and channel the station associates directly instead of scanning.
+ */
 void connectWiFi() {
-  pinMode(WIFI_STATUS_LED, OUTPUT);
-  digitalWrite(WIFI_STATUS_LED, LOW);
+  static bool configured = false;
+  if (!configured) {
+    configured = true;
+    pinMode(WIFI_STATUS_LED, OUTPUT);
+    WiFi.mode(WIFI_STA);
+    WiFi.persistent(false);
+    WiFi.setAutoReconnect(false); // Reconnects are driven from serviceWiFi()
+    WiFi.onEvent(onWiFiEvent);
+
+    loadApCache();
+  }
 
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASS);
-  
-  uint32_t startTime = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startTime < WIFI_TIMEOUT_MS) {
-    delay(250);
+  // Reuse the cached lease if we have one, otherwise ask DHCP
+  usingCachedIp = cachedIp != 0;
+  leaseVerified = false;
+  if (usingCachedIp) {
+    WiFi.config(IPAddress(cachedIp), WIFI_GATEWAY, WIFI_SUBNET);
+  } else {
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
   }
-  
-  if (WiFi.status() == WL_CONNECTED) {
+
+  digitalWrite(WIFI_STATUS_LED, LOW);
+  wifiConnecting = true;
+  wifiAttemptMs = millis();
+  attemptUsedApCache = cachedChannel && !scanNextAttempt;
+  scanNextAttempt = false;
+  if (attemptUsedApCache) {
+    WiFi.begin(WIFI_SSID, WIFI_PASS, cachedChannel, cachedBssid, true);
+  } else {
+    WiFi.begin(WIFI_SSID, WIFI_PASS);
+  }
+}
+
+/**
+ * Start over after an attempt that never associated. Nothing it used was proven wrong, so the
+ * lease and the AP cache are kept; a cached attempt is retried with a scan, and the cache is
+ * only replaced once that scan finds the AP somewhere else (see saveApCache).
+ */
+void retryWiFi() {
+  scanNextAttempt = attemptUsedApCache;
+  WiFi.disconnect();
+  connectWiFi();
+}
+
+void serviceWiFi() {
+  if (wifiGotIp) {
+    wifiGotIp = false;
+    wifiConnecting = false;
+    wifiUpMs = millis();
     digitalWrite(WIFI_STATUS_LED, HIGH);
+    saveApCache();
+    if (!usingCachedIp) {
+      saveLease();
+    }
+    // (Re)open the WebSocket right away instead of waiting for the retry interval
+    ws.begin(WS_HOST, WS_PORT, WS_PATH);
   }
-  else {
+
+  if (wifiLost) {
+    wifiLost = false;
     digitalWrite(WIFI_STATUS_LED, LOW);
+    if (wifiConnecting) {
+      // Association failed; no point waiting out the timeout
+      retryWiFi();
+    } else {
+      // The link was up, so the central may have restarted and reset its DHCP pool; a reused lease can't be trusted
+      if (usingCachedIp) {
+        forgetLease();
+      }
+      connectWiFi();
+    }
+  }
+
+  // A reused lease that can't reach the central is probably taken; get a fresh one from DHCP
+  if (usingCachedIp && !wifiConnecting && !leaseVerified) {
+    if (linkConnected()) {
+      leaseVerified = true;
+    } else if (millis() - wifiUpMs > WIFI_LEASE_VERIFY_MS) {
+      forgetLease();
+      WiFi.disconnect();
+      connectWiFi();
+    }
+  }
+
+  // Give up on an attempt that's taking too long
+  // Without a reused lease the attempt includes DHCP, so only the fully cached path gets the short timeout
+  uint32_t timeout = (attemptUsedApCache && usingCachedIp) ? WIFI_FAST_TIMEOUT_MS : WIFI_TIMEOUT_MS;
+  if (wifiConnecting && millis() - wifiAttemptMs > timeout) {
+    retryWiFi();
   }
 }
 
@@ -452,6 +795,8 @@ void handleExecutingState() {
   
   // Process successful action
   if (actionDetected && !actionDone) {
+    actionServerUs = nowServerUs();
+
     // Stop timer first to prevent race condition
     stopRoundTimer();
     
@@ -497,34 +842,23 @@ void setup() {
   // Initialize sensors
   initializeSensors();
 
-  // Connect to WiFi and WebSocket
-  connectWiFi();
-  ws.begin(WS_HOST, WS_PORT, WS_PATH);
-  ws.onEvent([](WStype_t t, uint8_t* p, size_t l){ wsEvent(t,p,l); });
-  ws.setReconnectInterval(1500);
+  // Bring up the link to the central
+  linkBegin();
 
   // Set initial state
-  currentState = (WiFi.isConnected() ? State::NET_CONNECT : State::BOOT);
+  currentState = State::NET_CONNECT;
 }
 
 void loop() {
   //detectPlace();
-  //Process WebSocket events
-  ws.loop();
-
-  // Send periodic status updates
-  if (millis() - lastSyncStatusMs > SYNC_PERIOD_MS) {
-    lastSyncStatusMs = millis();
-    if (ws.isConnected()) {
-      sendStatus();
-    }
-  }
+  // Process link events
+  linkLoop();
 
   // Handle current game state
   switch (currentState) {
     case State::WAIT_ROUND:
       // Check if it's time to start the round
-      if (nowServerMs() >= roundStartServerMs) {
+      if (nowServerUs() >= roundStartServerUs) {
         startRoundNow();
       }
       break;
@@ -538,9 +872,7 @@ void loop() {
       break;
 
     case State::NET_CONNECT:
-      if (!WiFi.isConnected()) {
-        connectWiFi();
-      }
+      // Connection progress is driven by linkLoop()
       break;
 
     default:
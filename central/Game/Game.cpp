@@ -1,14 +1,16 @@
 #include "Game.h"
+#include <esp_timer.h>
 
-Game::Game(AsyncWebSocket* ws) 
+Game::Game() 
   : m_phase(Phase::LOBBY), m_round(0), m_current_cmd(Command::SHAKE), m_current_ms_window(2500),
-    m_round0_ms(2500), m_decay_ms(150), m_min_ms(800), m_round_start_ms(0), 
-    m_deadline_ms(0), m_pause_queued(false), m_ws(ws) {
+    m_round0_ms(2500), m_decay_ms(150), m_min_ms(800), m_round_start_us(0), 
+    m_deadline_us(0), m_pause_queued(false), m_journal(nullptr) {
 }
 
 // Phase management
 void Game::setPhase(Phase phase) {
   if (m_phase != phase) {
+    if (m_journal) m_journal->recordPhase((uint8_t)m_phase, (uint8_t)phase);
     m_phase = phase;
     broadcastStateToWeb();
   }
@@ -54,12 +56,12 @@ void Game::setMinMs(uint32_t ms) {
   }
 }
 
-void Game::setRoundStartMs(uint64_t ms) {
-  m_round_start_ms = ms;
+void Game::setRoundStartUs(uint64_t us) {
+  m_round_start_us = us;
 }
 
-void Game::setDeadlineMs(uint64_t ms) {
-  m_deadline_ms = ms;
+void Game::setDeadlineUs(uint64_t us) {
+  m_deadline_us = us;
 }
 
 void Game::setPauseQueued(bool queued) {
@@ -89,6 +91,26 @@ Player& Game::addPlayer(const String& blockId) {
   return *playerPtr;
 }
 
+// Liveness
+void Game::touchPlayer(Player& player) {
+  m_liveness.touch(&player, nowUs());
+  player.setConnected(true);
+}
+
+int Game::expireIdlePlayers(uint32_t timeoutMs) {
+  std::vector<Player*> expired;
+  uint64_t now = nowUs();
+  m_liveness.expire(now, (uint64_t)timeoutMs * 1000, expired);
+
+  for (Player* p : expired) {
+    Serial.printf("Player timeout: %s (last seen %lu ms ago)\n",
+                  p->getBlockId().c_str(),
+                  (unsigned long)((now - p->getLastSeenUs()) / 1000));
+    p->setConnected(false);
+  }
+  return expired.size();
+}
+
 // Client management
 ClientMeta* Game::getClient(uint32_t id) {
   for (auto& c : m_clients) {
@@ -97,8 +119,8 @@ ClientMeta* Game::getClient(uint32_t id) {
   return nullptr;
 }
 
-void Game::addClient(uint32_t id) {
-  m_clients.push_back({id, "", ""});
+void Game::addClient(uint32_t id, Transport* transport) {
+  m_clients.push_back({id, "", "", transport, 0, transport && transport->isAuthenticated()});
 }
 
 void Game::removeClient(uint32_t id) {
@@ -133,6 +155,7 @@ void Game::nextRound() {
   
   setRound(m_round + 1);
   markRoundStartAndDeadline();
+  journalRound();
   broadcastRoundToBlocks();
 }
 
@@ -149,11 +172,12 @@ void Game::endRound() {
   uint32_t newWindow = (m_current_ms_window > m_decay_ms) ? 
                        m_current_ms_window - m_decay_ms : m_min_ms;
   setCurrentMsWindow(max(m_min_ms, newWindow));
+  journalOutcome();
 }
 
 void Game::markRoundStartAndDeadline() {
-  setRoundStartMs(millis() + 500); // prepare and send command 500ms before start (to account for transmission delay)
-  setDeadlineMs(m_round_start_ms + m_current_ms_window);
+  setRoundStartUs(nowUs() + 500000); // prepare and send command 500ms before start (to account for transmission delay)
+  setDeadlineUs(m_round_start_us + (uint64_t)m_current_ms_window * 1000);
 }
 
 Command Game::randomCmd() {
@@ -215,53 +239,251 @@ void Game::renamePlayer(const String& blockId, const String& name) {
   }
 }
 
+// Journal
+void Game::journalRound() {
+  if (!m_journal) return;
+
+  JournalRound r;
+  r.round = m_round;
+  r.cmd = (uint8_t)m_current_cmd;
+  r.windowMs = m_current_ms_window;
+  r.decayMs = m_decay_ms;
+  r.minMs = m_min_ms;
+  r.roundStartUs = m_round_start_us;
+  r.deadlineUs = m_deadline_us;
+  m_journal->recordRound(r);
+}
+
+void Game::journalPlayerConnected(const Player& player) {
+  // Liveness decides who is dealt into the next game, so replay needs every change
+  if (!m_journal) return;
+  m_journal->recordPlayerConnected(player.getBlockId(), player.isConnected());
+}
+
+void Game::journalCheckpoint() {
+  // Everything replay needs to start from the middle of a session: a rotated file begins here
+  if (!m_journal) return;
+
+  std::vector<uint8_t> snapshot = buildSnapshot();
+  m_journal->recordSnapshot(snapshot.data(), snapshot.size());
+
+  for (const auto& c : m_clients) {
+    uint8_t role = c.role == "block" ? 1 : (c.role == "web" ? 2 : 0);
+    m_journal->recordClientRole(c.id, role, c.authenticated, c.blockId);
+  }
+  for (const auto& p : m_players) {
+    m_journal->recordPlayerConnected(p->getBlockId(), p->isConnected());
+  }
+}
+
+void Game::journalOutcome() {
+  if (!m_journal) return;
+
+  // u16 count, then per player: u8 idLen, id, i32 score, u8 inGame
+  std::vector<uint8_t> out;
+  uint16_t count = (uint16_t)m_players.size();
+  out.push_back(count & 0xFF);
+  out.push_back(count >> 8);
+  for (const auto& p : m_players) {
+    const String& id = p->getBlockId();
+    uint8_t idLen = (uint8_t)min((size_t)id.length(), (size_t)255);
+    int32_t score = p->getScore();
+    out.push_back(idLen);
+    out.insert(out.end(), id.c_str(), id.c_str() + idLen);
+    const uint8_t* s = (const uint8_t*)&score;
+    out.insert(out.end(), s, s + sizeof(score));
+    out.push_back(p->isInGame() ? 1 : 0);
+  }
+  m_journal->recordOutcome(out.data(), out.size());
+}
+
+// Snapshot
+namespace {
+  const uint8_t SNAPSHOT_VERSION = 1;
+
+  void putBytes(std::vector<uint8_t>& out, const void* src, size_t len) {
+    const uint8_t* b = (const uint8_t*)src;
+    out.insert(out.end(), b, b + len);
+  }
+
+  void putString(std::vector<uint8_t>& out, const String& str) {
+    uint8_t len = (uint8_t)min((size_t)str.length(), (size_t)255);
+    out.push_back(len);
+    putBytes(out, str.c_str(), len);
+  }
+
+  bool getBytes(const uint8_t* data, size_t len, size_t& off, void* dst, size_t n) {
+    if (off + n > len) return false;
+    memcpy(dst, data + off, n);
+    off += n;
+    return true;
+  }
+
+  bool getString(const uint8_t* data, size_t len, size_t& off, String& str) {
+    uint8_t n;
+    if (!getBytes(data, len, off, &n, 1) || off + n > len) return false;
+    str = String((const char*)data + off, n);
+    off += n;
+    return true;
+  }
+}
+
+std::vector<uint8_t> Game::buildSnapshot() const {
+  // Only state that matters for resuming is stored, so the blob doesn't change on every heartbeat
+  std::vector<uint8_t> out;
+  out.push_back(SNAPSHOT_VERSION);
+  out.push_back((uint8_t)m_phase);
+  int32_t round = m_round;
+  putBytes(out, &round, 4);
+  out.push_back((uint8_t)m_current_cmd);
+  putBytes(out, &m_current_ms_window, 4);
+  putBytes(out, &m_round0_ms, 4);
+  putBytes(out, &m_decay_ms, 4);
+  putBytes(out, &m_min_ms, 4);
+
+  uint16_t count = (uint16_t)m_players.size();
+  putBytes(out, &count, 2);
+  for (const auto& p : m_players) {
+    putString(out, p->getBlockId());
+    putString(out, p->getName());
+    int32_t score = p->getScore();
+    putBytes(out, &score, 4);
+    out.push_back(p->isInGame() ? 1 : 0);
+  }
+  return out;
+}
+
+bool Game::restoreSnapshot(const uint8_t* data, size_t len) {
+  size_t off = 0;
+  uint8_t version, phase, cmd;
+  int32_t round;
+  uint32_t window, round0, decay, minMs;
+  uint16_t count;
+
+  if (!getBytes(data, len, off, &version, 1) || version != SNAPSHOT_VERSION) return false;
+  if (!getBytes(data, len, off, &phase, 1) || phase > (uint8_t)Phase::DONE) return false;
+  if (!getBytes(data, len, off, &round, 4)) return false;
+  if (!getBytes(data, len, off, &cmd, 1) || cmd > (uint8_t)Command::PLACE) return false;
+  if (!getBytes(data, len, off, &window, 4)) return false;
+  if (!getBytes(data, len, off, &round0, 4)) return false;
+  if (!getBytes(data, len, off, &decay, 4)) return false;
+  if (!getBytes(data, len, off, &minMs, 4)) return false;
+  if (!getBytes(data, len, off, &count, 2)) return false;
+
+  // Validate the whole blob before touching any state
+  std::vector<std::unique_ptr<Player>> players;
+  for (uint16_t i = 0; i < count; i++) {
+    String blockId, name;
+    int32_t score;
+    uint8_t inGame;
+    if (!getString(data, len, off, blockId)) return false;
+    if (!getString(data, len, off, name)) return false;
+    if (!getBytes(data, len, off, &score, 4)) return false;
+    if (!getBytes(data, len, off, &inGame, 1)) return false;
+
+    auto p = std::make_unique<Player>(blockId, this);
+    p->setName(name);
+    p->setScore(score);
+    p->setInGame(inGame != 0);
+    players.push_back(std::move(p));
+  }
+
+  // A game in progress resumes paused; blocks mark themselves connected when they re-hello
+  Phase restored = (Phase)phase;
+  if (restored == Phase::RUNNING || restored == Phase::WAITING_NEXT_ROUND) {
+    restored = Phase::PAUSED;
+  }
+
+  // Take the old players off the wheel before they are destroyed
+  m_liveness.clear();
+  m_players = std::move(players);
+  m_phase = restored;
+  m_round = round;
+  m_current_cmd = (Command)cmd;
+  m_current_ms_window = window;
+  m_round0_ms = round0;
+  m_decay_ms = decay;
+  m_min_ms = minMs;
+  m_round_start_us = 0;
+  m_deadline_us = 0;
+  m_pause_queued = false;
+
+  if (m_journal) m_journal->recordSnapshot(data, len);
+  broadcastStateToWeb();
+  return true;
+}
+
 // Broadcasting
+void Game::sendTo(const ClientMeta& client, const String& message, SendPolicy policy) {
+  if (!client.transport) return;
+  client.transport->send(client.id, (const uint8_t*)message.c_str(), message.length(), policy);
+}
+
 void Game::broadcastStateToWeb() {
-  if (!m_ws) return;
+  bool anyWeb = std::any_of(m_clients.begin(), m_clients.end(),
+                            [](const ClientMeta& c){ return c.role == "web" && c.transport; });
+  if (!anyWeb) return;
   
   String message = buildGameStateMessage();
   for (const auto& c : m_clients) {
     if (c.role == "web") {
-      m_ws->text(c.id, message);
+      sendTo(c, message, SendPolicy::LATEST_WINS);
     }
   }
 }
 
 void Game::broadcastStateToWeb(uint32_t clientId) {
-  if (!m_ws) return;
-  
   auto it = std::find_if(m_clients.begin(), m_clients.end(),
                          [clientId](const ClientMeta& c){ return c.id == clientId; });
   if (it == m_clients.end()) return;
 
   if (it->role != "web") return;
 
+  if (!it->transport) return;
+
   String message = buildGameStateMessage();
-  m_ws->text(clientId, message);
+  sendTo(*it, message, SendPolicy::LATEST_WINS);
 }
 
 void Game::broadcastRoundToBlocks() {
-  if (!m_ws) return;
-  
   JSONVar doc;
   doc["type"] = "round";
   doc["round"] = m_round;
   doc["cmd"] = commandToStr(m_current_cmd);
-  doc["roundStartMs"] = (unsigned long)m_round_start_ms;
-  doc["gameTimeMs"] = m_current_ms_window;
-  doc["deadlineMs"] = (unsigned long)m_deadline_ms;
+  // 64-bit microsecond stamps; doubles carry them exactly (53 bits covers centuries of uptime)
+  doc["roundStartUs"] = (double)m_round_start_us;
+  doc["deadlineUs"] = (double)m_deadline_us;
   
   String out = JSON.stringify(doc);
   for (const auto& c : m_clients) {
     if (c.role == "block" && c.blockId.length()) {
       Player* p = getPlayer(c.blockId);
       if (p && p->isInGame()) {
-        m_ws->text(c.id, out);
+        sendTo(c, out, SendPolicy::PRIORITY);
       }
     }
   }
 }
 
+void Game::sendTimeSync(ClientMeta& client) {
+  JSONVar syncMsg;
+  syncMsg["type"] = "sync";
+  syncMsg["serverTimeUs"] = (double)nowUs();
+
+  sendTo(client, JSON.stringify(syncMsg), SendPolicy::PRIORITY);
+  client.lastSyncMs = millis();
+}
+
+void Game::refreshTimeSync(uint32_t maxAgeMs) {
+  // Only blocks use the server clock; web clients never need it
+  uint32_t now = millis();
+  for (auto& c : m_clients) {
+    if (c.role == "block" && now - c.lastSyncMs >= maxAgeMs) {
+      sendTimeSync(c);
+    }
+  }
+}
+
 String Game::buildGameStateMessage() {
   JSONVar doc;
   doc["type"] = "state";
@@ -286,6 +508,11 @@ String Game::buildGameStateMessage() {
   return JSON.stringify(doc);
 }
 
+// Monotonic 64-bit microsecond clock shared by the central and the protocol; it never wraps in practice.
+uint64_t Game::nowUs() {
+  return (uint64_t)esp_timer_get_time();
+}
+
 String Game::phaseToStr(Phase ph) {
   switch (ph) {
     case Phase::LOBBY: return "LOBBY";
@@ -3,10 +3,12 @@
 
 #include <Arduino.h>
 #include <Arduino_JSON.h>
-#include <ESPAsyncWebServer.h>
 #include <vector>
 #include <memory>
 #include "../Player/Player.h"
+#include "../Journal/Journal.h"
+#include "../Transport/Transport.h"
+#include "../Liveness/LivenessWheel.h"
 
 enum class Phase { LOBBY, RUNNING, WAITING_NEXT_ROUND, PAUSED, DONE };
 enum class Command { SHAKE, MINE, PLACE };
@@ -15,6 +17,9 @@ struct ClientMeta {
   uint32_t id;
   String role;    // "block" | "web"
   String blockId; // set if role == "block"
+  Transport* transport; // how to reach this client (nullptr during replay)
+  uint32_t lastSyncMs;  // when this block last got a time sync
+  bool authenticated;   // arrived over a transport that requires the AP password
 };
 
 class Game {
@@ -27,20 +32,31 @@ private:
   uint32_t m_round0_ms;
   uint32_t m_decay_ms;
   uint32_t m_min_ms;
-  uint64_t m_round_start_ms;
-  uint64_t m_deadline_ms;
+  uint64_t m_round_start_us; // esp_timer microseconds
+  uint64_t m_deadline_us;
   bool m_pause_queued;
   
   // Players and clients
   std::vector<std::unique_ptr<Player>> m_players;
   std::vector<ClientMeta> m_clients;
+  LivenessWheel m_liveness;
   
-  // WebSocket reference
-  AsyncWebSocket* m_ws;
+  // Event journal (optional)
+  Journal* m_journal;
+
+  void journalRound();
+  void journalOutcome();
+  void sendTo(const ClientMeta& client, const String& message, SendPolicy policy);
 
 public:
   // Constructor
-  Game(AsyncWebSocket* ws);
+  Game();
+
+  // Journal
+  void setJournal(Journal* journal) { m_journal = journal; }
+  Journal* getJournal() const { return m_journal; }
+  void journalPlayerConnected(const Player& player);
+  void journalCheckpoint();
   
   // Phase management
   Phase getPhase() const { return m_phase; }
@@ -66,11 +82,11 @@ public:
   uint32_t getMinMs() const { return m_min_ms; }
   void setMinMs(uint32_t ms);
 
-  uint64_t getRoundStartMs() const { return m_round_start_ms; }
-  void setRoundStartMs(uint64_t ms);
+  uint64_t getRoundStartUs() const { return m_round_start_us; }
+  void setRoundStartUs(uint64_t us);
 
-  uint64_t getDeadlineMs() const { return m_deadline_ms; }
-  void setDeadlineMs(uint64_t ms);
+  uint64_t getDeadlineUs() const { return m_deadline_us; }
+  void setDeadlineUs(uint64_t us);
 
   bool isPauseQueued() const { return m_pause_queued; }
   void setPauseQueued(bool queued);
@@ -79,10 +95,14 @@ public:
   Player* getPlayer(const String& blockId);
   Player& addPlayer(const String& blockId);
   const std::vector<std::unique_ptr<Player>>& getPlayers() const { return m_players; }
+
+  // Liveness
+  void touchPlayer(Player& player);
+  int expireIdlePlayers(uint32_t timeoutMs);
   
   // Client management
   ClientMeta* getClient(uint32_t id);
-  void addClient(uint32_t id);
+  void addClient(uint32_t id, Transport* transport = nullptr);
   void removeClient(uint32_t id);
   const std::vector<ClientMeta>& getClients() const { return m_clients; }
   
@@ -101,14 +121,21 @@ public:
   void resetGame();
   void renamePlayer(const String& blockId, const String& name);
   
+  // Snapshot (persisted so a reset can resume the game)
+  std::vector<uint8_t> buildSnapshot() const;
+  bool restoreSnapshot(const uint8_t* data, size_t len);
+  
   // Broadcasting
   void broadcastStateToWeb();
   void broadcastStateToWeb(uint32_t clientId);
   void broadcastRoundToBlocks();
+  void sendTimeSync(ClientMeta& client);
+  void refreshTimeSync(uint32_t maxAgeMs);
   
   // Helper functions
   String buildGameStateMessage();
   static String phaseToStr(Phase ph);
+  static uint64_t nowUs();
   static String commandToStr(Command cmd);
   
 };
@@ -0,0 +1,205 @@
+#include "Journal.h"
+#include <esp_timer.h>
+
+Journal::Journal()
+  : m_head(0), m_pending(0), m_dropped(0), m_lock(portMUX_INITIALIZER_UNLOCKED),
+    m_fs(nullptr), m_path(nullptr), m_file_bytes(0) {
+}
+
+bool Journal::begin(fs::FS& fs, const char* path) {
+  m_fs = &fs;
+  m_path = path;
+
+  // Keep the previous game around so a reset doesn't destroy the evidence
+  if (!rotate()) {
+    m_fs = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool Journal::rotate() {
+  if (!m_fs || !m_path) return false;
+
+  String oldPath = getOldPath();
+  if (m_fs->exists(m_path)) {
+    m_fs->remove(oldPath);
+    m_fs->rename(m_path, oldPath);
+  }
+
+  fs::File f = m_fs->open(m_path, FILE_WRITE);
+  if (!f) return false;
+  f.close();
+  m_file_bytes = 0;
+  return true;
+}
+
+// Recording
+void Journal::record(JournalKind kind, const uint8_t* head, size_t headLen,
+                     const uint8_t* body, size_t bodyLen) {
+  // A truncated entry would decode as garbage, so oversized ones are dropped whole
+  if (headLen + bodyLen > MAX_PAYLOAD_BYTES) {
+    portENTER_CRITICAL(&m_lock);
+    m_dropped += HEADER_BYTES + headLen + bodyLen;
+    portEXIT_CRITICAL(&m_lock);
+    return;
+  }
+
+  uint8_t header[HEADER_BYTES];
+  uint64_t ts = (uint64_t)esp_timer_get_time();
+  uint16_t len = (uint16_t)(headLen + bodyLen);
+  memcpy(header, &ts, 8);
+  header[8] = (uint8_t)kind;
+  memcpy(header + 9, &len, 2);
+
+  const uint8_t* parts[3] = { header, head, body };
+  size_t sizes[3] = { HEADER_BYTES, headLen, bodyLen };
+  size_t total = HEADER_BYTES + len;
+
+  portENTER_CRITICAL(&m_lock);
+  // Drop the newest entry rather than overwrite unflushed ones so the file never holds partial entries
+  if (m_pending + total > JOURNAL_RING_BYTES) {
+    m_dropped += total;
+    portEXIT_CRITICAL(&m_lock);
+    return;
+  }
+  for (int i = 0; i < 3; i++) {
+    for (size_t j = 0; j < sizes[i]; j++) {
+      m_ring[m_head] = parts[i][j];
+      m_head = (m_head + 1) % JOURNAL_RING_BYTES;
+    }
+  }
+  m_pending += total;
+  portEXIT_CRITICAL(&m_lock);
+}
+
+void Journal::recordConnect(uint32_t clientId, bool authenticated) {
+  uint8_t payload[5];
+  memcpy(payload, &clientId, 4);
+  payload[4] = authenticated ? 1 : 0;
+  record(JournalKind::CLIENT_CONNECT, payload, sizeof(payload));
+}
+
+void Journal::recordDisconnect(uint32_t clientId) {
+  record(JournalKind::CLIENT_DISCONNECT, (const uint8_t*)&clientId, sizeof(clientId));
+}
+
+void Journal::recordInbound(uint32_t clientId, const uint8_t* data, size_t len) {
+  record(JournalKind::INBOUND, (const uint8_t*)&clientId, sizeof(clientId), data, len);
+}
+
+void Journal::recordAdmin(const String& action) {
+  record(JournalKind::ADMIN, (const uint8_t*)action.c_str(), action.length());
+}
+
+void Journal::recordPhase(uint8_t from, uint8_t to) {
+  uint8_t payload[2] = { from, to };
+  record(JournalKind::PHASE, payload, sizeof(payload));
+}
+
+void Journal::recordRound(const JournalRound& round) {
+  uint8_t payload[33];
+  memcpy(payload + 0, &round.round, 4);
+  payload[4] = round.cmd;
+  memcpy(payload + 5, &round.windowMs, 4);
+  memcpy(payload + 9, &round.decayMs, 4);
+  memcpy(payload + 13, &round.minMs, 4);
+  memcpy(payload + 17, &round.roundStartUs, 8);
+  memcpy(payload + 25, &round.deadlineUs, 8);
+  record(JournalKind::ROUND, payload, sizeof(payload));
+}
+
+void Journal::recordOutcome(const uint8_t* data, size_t len) {
+  record(JournalKind::OUTCOME, data, len);
+}
+
+void Journal::recordSnapshot(const uint8_t* data, size_t len) {
+  record(JournalKind::SNAPSHOT, data, len);
+}
+
+void Journal::recordPlayerConnected(const String& blockId, bool connected) {
+  uint8_t head[2] = { (uint8_t)(connected ? 1 : 0), (uint8_t)min((size_t)blockId.length(), (size_t)255) };
+  record(JournalKind::PLAYER_CONNECTED, head, sizeof(head), (const uint8_t*)blockId.c_str(), head[1]);
+}
+
+void Journal::recordClientRole(uint32_t clientId, uint8_t role, bool authenticated, const String& blockId) {
+  uint8_t head[7];
+  memcpy(head, &clientId, 4);
+  head[4] = role;
+  head[5] = authenticated ? 1 : 0;
+  head[6] = (uint8_t)min((size_t)blockId.length(), (size_t)255);
+  record(JournalKind::CLIENT_ROLE, head, sizeof(head), (const uint8_t*)blockId.c_str(), head[6]);
+}
+
+// Flushing
+bool Journal::flush() {
+  if (!m_fs || !m_path) return false;
+
+  portENTER_CRITICAL(&m_lock);
+  size_t count = m_pending;
+  size_t start = (m_head + JOURNAL_RING_BYTES - m_pending) % JOURNAL_RING_BYTES;
+  portEXIT_CRITICAL(&m_lock);
+
+  if (count == 0) return true;
+
+  // Past the cap the batch is discarded (and counted) so the ring keeps accepting new entries
+  if (m_file_bytes + count > JOURNAL_MAX_FILE_BYTES) {
+    portENTER_CRITICAL(&m_lock);
+    m_pending -= count;
+    m_dropped += count;
+    portEXIT_CRITICAL(&m_lock);
+    return false;
+  }
+
+  // Writers only touch free space, so the pending region is stable while we write it out
+  fs::File f = m_fs->open(m_path, FILE_APPEND);
+  if (!f) return false;
+
+  size_t first = min(count, (size_t)JOURNAL_RING_BYTES - start);
+  bool ok = f.write(m_ring + start, first) == first;
+  if (ok && count > first) {
+    ok = f.write(m_ring, count - first) == count - first;
+  }
+  f.close();
+
+  if (ok) {
+    m_file_bytes += count;
+    portENTER_CRITICAL(&m_lock);
+    m_pending -= count;
+    portEXIT_CRITICAL(&m_lock);
+  }
+  return ok;
+}
+
+// Reading
+size_t Journal::minPayloadLength(JournalKind kind) {
+  switch (kind) {
+    case JournalKind::CLIENT_CONNECT: return 5;
+    case JournalKind::CLIENT_DISCONNECT: return 4;
+    case JournalKind::INBOUND: return 4;
+    case JournalKind::PHASE: return 2;
+    case JournalKind::ROUND: return 33;
+    case JournalKind::OUTCOME: return 2;
+    case JournalKind::PLAYER_CONNECTED: return 2;
+    case JournalKind::CLIENT_ROLE: return 7;
+    default: return 0;
+  }
+}
+
+JournalRead Journal::readEntry(fs::File& file, JournalEntry& entry, uint8_t* buffer, size_t bufferLen) {
+  uint8_t header[HEADER_BYTES];
+  size_t got = file.read(header, HEADER_BYTES);
+  if (got == 0) return JournalRead::END;
+  if (got != HEADER_BYTES) return JournalRead::CORRUPT;
+
+  memcpy(&entry.timestampUs, header, 8);
+  entry.kind = (JournalKind)header[8];
+  memcpy(&entry.length, header + 9, 2);
+
+  // record() never writes more than MAX_PAYLOAD_BYTES, so a longer length means the file is damaged
+  if (entry.length > MAX_PAYLOAD_BYTES || entry.length > bufferLen) return JournalRead::CORRUPT;
+  if (file.read(buffer, entry.length) != entry.length) return JournalRead::CORRUPT;
+
+  entry.payload = buffer;
+  return JournalRead::ENTRY;
+}
@@ -0,0 +1,121 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+// Size of the in-RAM ring buffer holding entries that are not yet on flash
+#ifndef JOURNAL_RING_BYTES
+#define JOURNAL_RING_BYTES 8192
+#endif
+
+// Hard limit on the journal file; entries beyond it are dropped rather than filling the filesystem
+#ifndef JOURNAL_MAX_FILE_BYTES
+#define JOURNAL_MAX_FILE_BYTES (192 * 1024)
+#endif
+
+// Kinds of entries stored in the journal
+enum class JournalKind : uint8_t {
+  CLIENT_CONNECT = 1,    // payload: u32 clientId, u8 authenticated
+  CLIENT_DISCONNECT = 2, // payload: u32 clientId
+  INBOUND = 3,           // payload: u32 clientId, raw message bytes
+  ADMIN = 4,             // payload: action string
+  PHASE = 5,             // payload: u8 from, u8 to
+  ROUND = 6,             // payload: see JournalRound
+  OUTCOME = 7,           // payload: u16 count, then per player: u8 idLen, id, i32 score, u8 inGame
+  SNAPSHOT = 8,          // payload: Game snapshot restored at boot
+  PLAYER_CONNECTED = 9,  // payload: u8 connected, u8 idLen, id
+  CLIENT_ROLE = 10       // payload: u32 clientId, u8 role (0 none, 1 block, 2 web), u8 authenticated, u8 idLen, blockId
+};
+
+// Round parameters as recorded when a round is issued
+struct JournalRound {
+  int32_t round;
+  uint8_t cmd;
+  uint32_t windowMs;
+  uint32_t decayMs;
+  uint32_t minMs;
+  uint64_t roundStartUs;
+  uint64_t deadlineUs;
+};
+
+// Result of decoding the next entry from a journal file
+enum class JournalRead {
+  ENTRY,   // an entry was decoded
+  END,     // clean end of file
+  CORRUPT  // truncated entry or a length no valid entry can have
+};
+
+// A single decoded journal entry; payload points into the reader's buffer
+struct JournalEntry {
+  uint64_t timestampUs;
+  JournalKind kind;
+  uint16_t length;
+  const uint8_t* payload;
+};
+
+/**
+ * Append-only binary journal of everything that influences the outcome of a game.
+ *
+ * Entries are packed little-endian as [u64 timestampUs][u8 kind][u16 length][payload].
+ * Recording only copies into a RAM ring buffer so it is safe to call from the
+ * WebSocket task and from round timing; flush() moves complete batches to flash
+ * and should be called from loop() outside the timing critical path.
+ */
+class Journal {
+private:
+  uint8_t m_ring[JOURNAL_RING_BYTES];
+  size_t m_head;    // next write position
+  size_t m_pending; // bytes recorded but not yet flushed
+  uint32_t m_dropped;
+  portMUX_TYPE m_lock;
+
+  fs::FS* m_fs;
+  const char* m_path;
+  size_t m_file_bytes; // size of the current journal file
+
+  void record(JournalKind kind, const uint8_t* head, size_t headLen,
+              const uint8_t* body = nullptr, size_t bodyLen = 0);
+
+public:
+  static const size_t HEADER_BYTES = 11;
+  static const size_t MAX_PAYLOAD_BYTES = 1024;
+
+  Journal();
+
+  // Attach flash storage; the previous journal (if any) is kept as <path>.old
+  bool begin(fs::FS& fs, const char* path);
+
+  // Start a new file, keeping the current one as <path>.old; call after flush() from loop()
+  bool rotate();
+  size_t fileBytes() const { return m_file_bytes; }
+
+  // Recording (RAM only)
+  void recordConnect(uint32_t clientId, bool authenticated);
+  void recordDisconnect(uint32_t clientId);
+  void recordInbound(uint32_t clientId, const uint8_t* data, size_t len);
+  void recordAdmin(const String& action);
+  void recordPhase(uint8_t from, uint8_t to);
+  void recordRound(const JournalRound& round);
+  void recordOutcome(const uint8_t* data, size_t len);
+  void recordSnapshot(const uint8_t* data, size_t len);
+  void recordPlayerConnected(const String& blockId, bool connected);
+  void recordClientRole(uint32_t clientId, uint8_t role, bool authenticated, const String& blockId);
+
+  // Flushing
+  size_t pendingBytes() const { return m_pending; }
+  uint32_t droppedBytes() const { return m_dropped; }
+  bool flush();
+
+  const char* getPath() const { return m_path; }
+  String getOldPath() const { return String(m_path) + ".old"; }
+  fs::FS* getFs() const { return m_fs; }
+
+  // Smallest valid payload for an entry kind
+  static size_t minPayloadLength(JournalKind kind);
+
+  // Decode the next entry from a flushed journal file
+  static JournalRead readEntry(fs::File& file, JournalEntry& entry, uint8_t* buffer, size_t bufferLen);
+};
+
+#endif // JOURNAL_H
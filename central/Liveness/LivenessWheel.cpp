@@ -0,0 +1,79 @@
+#include "LivenessWheel.h"
+#include "../Player/Player.h"
+
+LivenessWheel::LivenessWheel() : m_next_tick(0) {
+  for (auto& head : m_slots) {
+    head = nullptr;
+  }
+}
+
+void LivenessWheel::link(Player* player, int slot) {
+  player->m_wheel_slot = slot;
+  player->m_wheel_prev = nullptr;
+  player->m_wheel_next = m_slots[slot];
+  if (m_slots[slot]) m_slots[slot]->m_wheel_prev = player;
+  m_slots[slot] = player;
+}
+
+void LivenessWheel::unlink(Player* player) {
+  if (player->m_wheel_slot < 0) return;
+
+  if (player->m_wheel_prev) {
+    player->m_wheel_prev->m_wheel_next = player->m_wheel_next;
+  } else {
+    m_slots[player->m_wheel_slot] = player->m_wheel_next;
+  }
+  if (player->m_wheel_next) player->m_wheel_next->m_wheel_prev = player->m_wheel_prev;
+
+  player->m_wheel_prev = nullptr;
+  player->m_wheel_next = nullptr;
+  player->m_wheel_slot = -1;
+}
+
+void LivenessWheel::touch(Player* player, uint64_t nowUs) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  player->setLastSeenUs(nowUs);
+
+  int slot = tickOf(nowUs) % LIVENESS_SLOTS;
+  if (player->m_wheel_slot == slot) return;
+
+  unlink(player);
+  link(player, slot);
+}
+
+void LivenessWheel::expire(uint64_t nowUs, uint64_t timeoutUs, std::vector<Player*>& expired) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (nowUs < timeoutUs) return;
+
+  // A bucket has aged out once even its last microsecond is a full timeout old
+  uint64_t firstLiveTick = tickOf(nowUs - timeoutUs + 1);
+  if (firstLiveTick <= m_next_tick) return;
+  uint64_t lastExpiredTick = firstLiveTick - 1;
+
+  // Visit each slot at most once even if we fell far behind
+  uint64_t span = min(lastExpiredTick - m_next_tick + 1, (uint64_t)LIVENESS_SLOTS);
+  for (uint64_t i = 0; i < span; i++) {
+    Player* p = m_slots[(lastExpiredTick - i) % LIVENESS_SLOTS];
+    while (p) {
+      Player* next = p->m_wheel_next;
+      // A newer lap only shares the slot when the wheel is shorter than the timeout
+      if (tickOf(p->getLastSeenUs()) <= lastExpiredTick) {
+        unlink(p);
+        if (p->isConnected()) expired.push_back(p);
+      }
+      p = next;
+    }
+  }
+
+  m_next_tick = firstLiveTick;
+}
+
+void LivenessWheel::clear() {
+  std::lock_guard<std::mutex> guard(m_lock);
+  for (auto& head : m_slots) {
+    while (head) {
+      unlink(head);
+    }
+  }
+  m_next_tick = 0;
+}
@@ -0,0 +1,53 @@
+#ifndef LIVENESS_WHEEL_H
+#define LIVENESS_WHEEL_H
+
+#include <Arduino.h>
+#include <vector>
+#include <mutex>
+
+class Player;
+
+// Width of one last-seen bucket
+#ifndef LIVENESS_BUCKET_MS
+#define LIVENESS_BUCKET_MS 250
+#endif
+
+// Number of buckets on the wheel; should span at least the player timeout
+#ifndef LIVENESS_SLOTS
+#define LIVENESS_SLOTS 32
+#endif
+
+/**
+ * Timing wheel of last-seen buckets. Each player sits in the intrusive list of the bucket it
+ * was last seen in; touch() moves it to the current bucket in O(1), so a bucket that has aged
+ * out holds only players that went idle, and expire() visits nothing but those. A player
+ * expires once it has been idle for the whole timeout: at most one bucket late, never early.
+ *
+ * touch() runs on the WebSocket task and expire() from loop(), so both (and the list links
+ * and last-seen time on Player) are guarded by a mutex.
+ */
+class LivenessWheel {
+private:
+  Player* m_slots[LIVENESS_SLOTS]; // list heads
+  uint64_t m_next_tick; // oldest tick not yet expired
+  std::mutex m_lock;
+
+  static uint64_t tickOf(uint64_t us) { return us / ((uint64_t)LIVENESS_BUCKET_MS * 1000); }
+
+  void link(Player* player, int slot);
+  void unlink(Player* player);
+
+public:
+  LivenessWheel();
+
+  // Record that a player was seen and update its last-seen time
+  void touch(Player* player, uint64_t nowUs);
+
+  // Collect players not seen for timeoutUs into expired and take them off the wheel
+  void expire(uint64_t nowUs, uint64_t timeoutUs, std::vector<Player*>& expired);
+
+  // Take every player off the wheel; call before the players are destroyed
+  void clear();
+};
+
+#endif // LIVENESS_WHEEL_H
@@ -3,7 +3,8 @@
 
 Player::Player(const String& blockId, Game* game) 
   : m_block_id(blockId), m_name(blockId), m_connected(false), m_in_game(false), 
-    m_score(0), m_last_seen_ms(0), m_reported(false), m_success(false), m_game(game) {
+    m_score(0), m_last_seen_us(0), m_reported(false), m_success(false), m_game(game),
+    m_wheel_prev(nullptr), m_wheel_next(nullptr), m_wheel_slot(-1) {
 }
 
 void Player::setName(const String& name) {
@@ -16,6 +17,7 @@ void Player::setName(const String& name) {
 void Player::setConnected(bool connected) {
   if (m_connected != connected) {
     m_connected = connected;
+    if (m_game) m_game->journalPlayerConnected(*this);
     notifyChange();
   }
 }
@@ -39,8 +41,8 @@ void Player::incrementScore() {
   notifyChange();
 }
 
-void Player::setLastSeenMs(uint32_t lastSeenMs) {
-  m_last_seen_ms = lastSeenMs;
+void Player::setLastSeenUs(uint64_t lastSeenUs) {
+  m_last_seen_us = lastSeenUs;
 }
 
 void Player::setReported(bool reported) {
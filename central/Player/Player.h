@@ -14,7 +14,7 @@ private:
   bool m_connected;
   bool m_in_game;
   int m_score;
-  uint32_t m_last_seen_ms;
+  uint64_t m_last_seen_us;
 
   // Temporary round variables
   bool m_reported;
@@ -23,6 +23,12 @@ private:
   // Reference to game for broadcasting
   Game* m_game;
 
+  // Links in the LivenessWheel bucket the player was last seen in; owned by the wheel
+  Player* m_wheel_prev;
+  Player* m_wheel_next;
+  int m_wheel_slot; // -1 while not on the wheel
+  friend class LivenessWheel;
+
 public:
   // Constructor
   Player(const String& blockId, Game* game = nullptr);
@@ -33,7 +39,7 @@ public:
   bool isConnected() const { return m_connected; }
   bool isInGame() const { return m_in_game; }
   int getScore() const { return m_score; }
-  uint32_t getLastSeenMs() const { return m_last_seen_ms; }
+  uint64_t getLastSeenUs() const { return m_last_seen_us; }
   bool hasReported() const { return m_reported; }
   bool wasSuccessful() const { return m_success; }
   
@@ -43,7 +49,7 @@ public:
   void setInGame(bool inGame);
   void setScore(int score);
   void incrementScore();
-  void setLastSeenMs(uint32_t lastSeenMs);
+  void setLastSeenUs(uint64_t lastSeenUs);
   void setReported(bool reported);
   void setSuccess(bool success);
   void setGame(Game* game) { m_game = game; }
@@ -0,0 +1,437 @@
+#include "Protocol.h"
+
+// ======================== MESSAGE HANDLERS ========================
+// Handlers take the game explicitly so the journal replay can run them against a scratch instance
+
+void handleBlockHello(Game& g, uint32_t clientId, JSONVar& doc) {
+  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
+  ClientMeta* meta = g.getClient(clientId);
+  if (!meta) {
+    return;
+  }
+  
+  meta->role = "block";
+  meta->blockId = blockId;
+
+  Player& player = g.addPlayer(blockId);
+  g.touchPlayer(player);
+
+  // The block needs the server clock before its first round
+  g.sendTimeSync(*meta);
+}
+
+void handleWebHello(Game& g, uint32_t clientId, JSONVar& /*doc*/) {
+  // Dashboards can administer the game, so they must come through the password-protected AP
+  ClientMeta* meta = g.getClient(clientId);
+  if (!meta || !meta->authenticated) {
+    return;
+  }
+  
+  meta->role = "web";
+  meta->blockId = ""; // Web clients don't have block IDs
+  
+  Serial.printf("Web client connected: %u\n", clientId);
+  
+  // Send current game state to the newly connected web client
+  g.broadcastStateToWeb(clientId);
+}
+
+// A block may only speak for the blockId it said hello with
+bool isSenderOf(Game& g, uint32_t clientId, const String& blockId) {
+  ClientMeta* meta = g.getClient(clientId);
+  return meta && meta->role == "block" && meta->blockId == blockId;
+}
+
+void handleBlockStatus(Game& g, uint32_t clientId, JSONVar& doc) {
+  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
+  if (!isSenderOf(g, clientId, blockId)) {
+    return;
+  }
+  Player* player = g.getPlayer(blockId);
+  if (!player) {
+    return;
+  }
+  
+  g.touchPlayer(*player);
+}
+
+void handleBlockResult(Game& g, uint32_t clientId, JSONVar& doc) {
+  // Only accept results during active game phases
+  Phase currentPhase = g.getPhase();
+  if (currentPhase != Phase::RUNNING && currentPhase != Phase::WAITING_NEXT_ROUND) {
+    return;
+  }
+
+  // Validate round number
+  int round = doc.hasOwnProperty("round") ? (int)doc["round"] : -999;
+  if (round != g.getRound()) {
+    return;
+  }
+  
+  // Validate block ID
+  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
+  if (!isSenderOf(g, clientId, blockId)) {
+    return;
+  }
+  Player* player = g.getPlayer(blockId);
+  if (!player) {
+    return;
+  }
+  
+  if (!player->isInGame()) {
+    return;
+  }
+
+  // Process the result; an action stamped after the deadline counts as a miss
+  bool actionDone = doc.hasOwnProperty("actionDone") ? (bool)doc["actionDone"] : false;
+  if (actionDone && doc.hasOwnProperty("actionUs") && (uint64_t)(double)doc["actionUs"] > g.getDeadlineUs()) {
+    actionDone = false;
+  }
+  player->setReported(true);
+  player->setSuccess(actionDone);
+  
+  if (actionDone) {
+    player->incrementScore();
+  }
+}
+
+void handleAdmin(Game& g, uint32_t clientId, JSONVar& doc) {
+  // Verify client authentication
+  ClientMeta* meta = g.getClient(clientId);
+  if (!meta || !meta->authenticated || meta->role != "web") {
+    return;
+  }
+  
+  String action = doc.hasOwnProperty("action") ? (const char*)doc["action"] : "";
+  if (action.isEmpty()) {
+    return;
+  }
+
+  if (g.getJournal()) {
+    g.getJournal()->recordAdmin(action);
+  }
+
+  // Process admin commands
+  if (action == "start") {
+    uint32_t round0Ms = doc.hasOwnProperty("round0Ms") ? (uint32_t)(int)doc["round0Ms"] : 2500;
+    uint32_t decayMs = doc.hasOwnProperty("decayMs") ? (uint32_t)(int)doc["decayMs"] : 150;
+    uint32_t minMs = doc.hasOwnProperty("minMs") ? (uint32_t)(int)doc["minMs"] : 800;
+    
+    g.startGame(round0Ms, decayMs, minMs);
+    
+  } else if (action == "pause") {
+    g.pauseGame();
+    
+  } else if (action == "resume") {
+    g.resumeGame();
+    
+  } else if (action == "reset") {
+    g.resetGame();
+    
+  } else if (action == "rename") {
+    String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
+    String name = doc.hasOwnProperty("name") ? (const char*)doc["name"] : "";
+    
+    if (blockId.isEmpty() || name.isEmpty()) {
+      return;
+    }
+    
+    g.renamePlayer(blockId, name);
+    
+  } else {
+    // Unknown admin action
+  }
+}
+
+void touchClient(Game& g, uint32_t clientId) {
+  // Any sign of life from a block counts towards its liveness
+  ClientMeta* meta = g.getClient(clientId);
+  if (!meta || meta->role != "block") {
+    return;
+  }
+
+  Player* player = g.getPlayer(meta->blockId);
+  if (player) {
+    g.touchPlayer(*player);
+  }
+}
+
+void handleClientDisconnect(Game& g, uint32_t clientId) {
+  // Handle block disconnection
+  ClientMeta* meta = g.getClient(clientId);
+  if (meta && meta->role == "block" && !meta->blockId.isEmpty()) {
+    Player* player = g.getPlayer(meta->blockId);
+    if (player) {
+      player->setConnected(false);
+    }
+  }
+  
+  g.removeClient(clientId);
+}
+
+void dispatchMessage(Game& g, uint32_t clientId, const uint8_t* data, size_t len) {
+  // Parse and validate JSON message
+  if (len == 0 || !data) {
+    return;
+  }
+  
+  String jsonString = String((const char*)data, len);
+  JSONVar doc = JSON.parse(jsonString);
+  
+  if (JSON.typeof(doc) == "undefined") {
+    return;
+  }
+
+  // Route message based on type
+  String msgType = doc.hasOwnProperty("type") ? (const char*)doc["type"] : "";
+  if (msgType.isEmpty()) {
+    return;
+  }
+  
+  if (msgType == "hello") {
+    handleBlockHello(g, clientId, doc);
+  } else if (msgType == "web-hello") {
+    handleWebHello(g, clientId, doc);
+  } else if (msgType == "status") {
+    handleBlockStatus(g, clientId, doc);
+  } else if (msgType == "result") {
+    handleBlockResult(g, clientId, doc);
+  } else if (msgType == "admin") {
+    handleAdmin(g, clientId, doc);
+  }
+}
+
+void handleTransportEvent(Game& g, Transport& transport, TransportEvent event, uint32_t clientId,
+                          const uint8_t* data, size_t len) {
+  Journal* journal = g.getJournal();
+
+  switch (event) {
+    case TransportEvent::CONNECT:
+      if (journal) journal->recordConnect(clientId, transport.isAuthenticated());
+      g.addClient(clientId, &transport);
+      // Initial state will be sent after hello message
+      break;
+      
+    case TransportEvent::DISCONNECT:
+      if (journal) journal->recordDisconnect(clientId);
+      handleClientDisconnect(g, clientId);
+      break;
+      
+    case TransportEvent::DATA:
+      if (journal) journal->recordInbound(clientId, data, len);
+      dispatchMessage(g, clientId, data, len);
+      touchClient(g, clientId);
+      break;
+
+    case TransportEvent::ALIVE:
+      touchClient(g, clientId);
+      break;
+  }
+}
+
+// ======================== JOURNAL REPLAY ========================
+
+/**
+ * Feed the flushed journal back through a scratch Game and the message handlers above,
+ * and check that every recorded round outcome (scores and eliminations) is reproduced.
+ * Round transitions are taken from the journal so replay doesn't depend on wall time or RNG.
+ */
+String replayJournal(Journal& journal, const String& path) {
+  JSONVar report;
+  report["file"] = path;
+  fs::FS* fs = journal.getFs();
+  fs::File file = fs && fs->exists(path) ? fs->open(path, FILE_READ) : fs::File();
+  if (!file) {
+    report["ok"] = false;
+    report["error"] = "journal unavailable";
+    return JSON.stringify(report);
+  }
+
+  Game replay;
+  static uint8_t buffer[Journal::MAX_PAYLOAD_BYTES];
+  JournalEntry entry;
+  uint32_t entries = 0;
+  uint32_t outcomes = 0;
+  uint32_t mismatches = 0;
+  int firstMismatchRound = -1;
+  bool malformed = false;
+
+  while (!malformed) {
+    JournalRead read = Journal::readEntry(file, entry, buffer, sizeof(buffer));
+    if (read == JournalRead::END) {
+      break;
+    }
+    entries++;
+    if (read == JournalRead::CORRUPT) {
+      malformed = true;
+      break;
+    }
+
+    const uint8_t* p = entry.payload;
+    const size_t len = entry.length;
+    uint32_t clientId = 0;
+
+    if (len < Journal::minPayloadLength(entry.kind)) {
+      malformed = true;
+      break;
+    }
+
+    switch (entry.kind) {
+      case JournalKind::CLIENT_CONNECT:
+        memcpy(&clientId, p, 4);
+        replay.addClient(clientId);
+        replay.getClient(clientId)->authenticated = p[4] != 0;
+        break;
+
+      case JournalKind::CLIENT_DISCONNECT:
+        memcpy(&clientId, p, 4);
+        handleClientDisconnect(replay, clientId);
+        break;
+
+      case JournalKind::INBOUND:
+        memcpy(&clientId, p, 4);
+        dispatchMessage(replay, clientId, p + 4, len - 4);
+        break;
+
+      case JournalKind::PHASE:
+        replay.setPhase((Phase)p[1]);
+        break;
+
+      case JournalKind::PLAYER_CONNECTED:
+      {
+        if (2 + (size_t)p[1] > len) {
+          malformed = true;
+          break;
+        }
+        Player* pl = replay.getPlayer(String((const char*)p + 2, p[1]));
+        if (pl) pl->setConnected(p[0] != 0);
+        break;
+      }
+
+      case JournalKind::CLIENT_ROLE:
+      {
+        if (7 + (size_t)p[6] > len) {
+          malformed = true;
+          break;
+        }
+        memcpy(&clientId, p, 4);
+        if (!replay.getClient(clientId)) replay.addClient(clientId);
+        ClientMeta* meta = replay.getClient(clientId);
+        meta->role = p[4] == 1 ? "block" : (p[4] == 2 ? "web" : "");
+        meta->authenticated = p[5] != 0;
+        meta->blockId = String((const char*)p + 7, p[6]);
+        break;
+      }
+
+      case JournalKind::SNAPSHOT:
+        replay.restoreSnapshot(p, len); // validates its own bounds
+        break;
+
+      case JournalKind::ROUND:
+      {
+        int32_t round;
+        uint64_t startUs, deadlineUs;
+        memcpy(&round, p + 0, 4);
+        memcpy(&startUs, p + 17, 8);
+        memcpy(&deadlineUs, p + 25, 8);
+        replay.setCurrentCmd((Command)p[4]);
+        replay.resetRoundFlags();
+        replay.setRound(round);
+        replay.setRoundStartUs(startUs);
+        replay.setDeadlineUs(deadlineUs);
+        break;
+      }
+
+      case JournalKind::OUTCOME:
+      {
+        replay.endRound();
+        outcomes++;
+
+        uint16_t count;
+        memcpy(&count, p, 2);
+        size_t off = 2;
+        bool match = (count == replay.getPlayers().size());
+        for (uint16_t i = 0; match && i < count; i++) {
+          if (off + 1 > len || off + 1 + p[off] + 5 > len) {
+            malformed = true;
+            break;
+          }
+          uint8_t idLen = p[off++];
+          String blockId = String((const char*)p + off, idLen);
+          off += idLen;
+          int32_t score;
+          memcpy(&score, p + off, 4);
+          off += 4;
+          bool inGame = p[off++] != 0;
+
+          Player* pl = replay.getPlayer(blockId);
+          match = pl && pl->getScore() == score && pl->isInGame() == inGame;
+        }
+
+        if (!match && !malformed) {
+          mismatches++;
+          if (firstMismatchRound < 0) firstMismatchRound = replay.getRound();
+        }
+        break;
+      }
+
+      default:
+        // ADMIN entries are informational; the inbound message already drives replay
+        break;
+    }
+  }
+  file.close();
+
+  if (malformed) {
+    report["error"] = "malformed entry";
+    report["malformedEntry"] = (int)entries;
+  }
+  report["ok"] = (mismatches == 0 && !malformed);
+  report["entries"] = (int)entries;
+  report["rounds"] = (int)outcomes;
+  report["mismatches"] = (int)mismatches;
+  report["firstMismatchRound"] = firstMismatchRound;
+  report["droppedBytes"] = (int)journal.droppedBytes();
+  return JSON.stringify(report);
+}
+
+// ======================== LIVENESS ========================
+
+void pingBlocks(Game& g) {
+  for (const auto& c : g.getClients()) {
+    if (c.role == "block" && c.transport) {
+      c.transport->ping(c.id);
+    }
+  }
+}
+
+// ======================== ROUND TIMING ========================
+
+void processRoundTiming(Game& g) {
+  Phase currentPhase = g.getPhase();
+  uint64_t currentTime = Game::nowUs();
+  
+  // Check for round end during active gameplay
+  if (currentPhase == Phase::RUNNING) {
+    if (currentTime > g.getDeadlineUs() + (uint64_t)DEADLINE_GRACE_MS * 1000) {
+      g.endRound();
+      
+      // Schedule next round
+      g.setRoundStartUs(currentTime + (uint64_t)ROUND_DELAY_MS * 1000);
+      g.setPhase(Phase::WAITING_NEXT_ROUND);
+    }
+  }
+  
+  // Handle scheduled next round start
+  else if (currentPhase == Phase::WAITING_NEXT_ROUND) {
+    if (currentTime >= g.getRoundStartUs()) {
+      if (g.isPauseQueued()) {
+        g.setPauseQueued(false);
+        g.setPhase(Phase::PAUSED);
+      } else {
+        g.setPhase(Phase::RUNNING);
+        g.nextRound();
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <Arduino.h>
+#include <Arduino_JSON.h>
+#include <FS.h>
+#include "../Game/Game.h"
+#include "../Journal/Journal.h"
+#include "../Transport/Transport.h"
+
+// Protocol timing (milliseconds)
+const uint32_t PING_INTERVAL_MS = 1000;  // Liveness ping interval for blocks
+const uint32_t SYNC_REFRESH_MS = 15000;  // Time sync refresh interval per block (also sent on hello)
+const uint32_t PLAYER_TIMEOUT_MS = 5000; // Player disconnect timeout
+const uint32_t ROUND_DELAY_MS = 800;     // Delay between rounds
+const uint32_t DEADLINE_GRACE_MS = 20;   // Grace period after round deadline
+
+/**
+ * The message protocol between clients and the central, independent of how messages travel.
+ * Everything takes the Game explicitly so the same code drives the live game, journal replay
+ * and the host tests in test/host.
+ */
+
+// Route one transport event (journaled first) to the handlers
+void handleTransportEvent(Game& g, Transport& transport, TransportEvent event, uint32_t clientId,
+                          const uint8_t* data, size_t len);
+
+// Parse one inbound JSON message and run its handler
+void dispatchMessage(Game& g, uint32_t clientId, const uint8_t* data, size_t len);
+void touchClient(Game& g, uint32_t clientId);
+void handleClientDisconnect(Game& g, uint32_t clientId);
+
+// Feed a journal file through a scratch Game and report whether recorded outcomes are reproduced
+String replayJournal(Journal& journal, const String& path);
+
+// Ask every block to prove it is alive; call every PING_INTERVAL_MS
+void pingBlocks(Game& g);
+
+// End rounds past their deadline and start scheduled ones; call from loop() while a game runs
+void processRoundTiming(Game& g);
+
+#endif // PROTOCOL_H
@@ -0,0 +1,116 @@
+#include "EspNowTransport.h"
+#include <WiFi.h>
+
+// Frames waiting to be delivered from loop()
+const size_t ESPNOW_RX_QUEUE_LEN = 16;
+
+EspNowTransport* EspNowTransport::s_instance = nullptr;
+
+EspNowTransport::EspNowTransport() : m_rx_queue(nullptr) {
+}
+
+bool EspNowTransport::begin() {
+  m_rx_queue = xQueueCreate(ESPNOW_RX_QUEUE_LEN, sizeof(Frame));
+  if (!m_rx_queue) return false;
+
+  if (esp_now_init() != ESP_OK) return false;
+
+  s_instance = this;
+  esp_now_register_recv_cb(onReceive);
+  return true;
+}
+
+void EspNowTransport::onReceive(const esp_now_recv_info* info, const uint8_t* data, int len) {
+  if (!s_instance || !info || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return;
+
+  // Runs in the WiFi task: copy and hand off without touching game state
+  Frame frame;
+  memcpy(frame.mac, info->src_addr, 6);
+  frame.len = (uint8_t)len;
+  memcpy(frame.data, data, len);
+  xQueueSend(s_instance->m_rx_queue, &frame, 0);
+}
+
+// A block's answer to ping(); it writes "type" first, so the prefix is enough to tell
+static bool isPong(const uint8_t* data, size_t len) {
+  static const char PONG[] = "{\"type\":\"pong\"";
+  return len >= sizeof(PONG) - 1 && memcmp(data, PONG, sizeof(PONG) - 1) == 0;
+}
+
+// Peer management
+EspNowTransport::Peer* EspNowTransport::findPeer(const uint8_t* mac) {
+  for (auto& p : m_peers) {
+    if (memcmp(p.mac, mac, 6) == 0) return &p;
+  }
+  return nullptr;
+}
+
+EspNowTransport::Peer* EspNowTransport::findPeer(uint32_t clientId) {
+  for (auto& p : m_peers) {
+    if (p.id == clientId) return &p;
+  }
+  return nullptr;
+}
+
+void EspNowTransport::poll() {
+  if (!m_rx_queue) return;
+
+  Frame frame;
+  while (xQueueReceive(m_rx_queue, &frame, 0) == pdTRUE) {
+    uint32_t clientId;
+    bool added = false;
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      Peer* peer = findPeer(frame.mac);
+      if (peer) {
+        clientId = peer->id;
+      } else {
+        esp_now_peer_info_t info = {};
+        memcpy(info.peer_addr, frame.mac, 6);
+        info.channel = 0; // current channel
+        info.ifidx = WIFI_IF_AP;
+        info.encrypt = false;
+        if (esp_now_add_peer(&info) != ESP_OK) continue;
+
+        Peer p;
+        memcpy(p.mac, frame.mac, 6);
+        p.id = ESPNOW_CLIENT_ID_BASE + m_peers.size();
+        m_peers.push_back(p);
+        clientId = p.id;
+        added = true;
+      }
+    }
+
+    // Handlers may send() back, so events are emitted without holding the lock
+    if (added) {
+      emit(TransportEvent::CONNECT, clientId);
+    }
+    // Pongs are liveness like WebSocket pong frames, not messages to journal and dispatch
+    if (isPong(frame.data, frame.len)) {
+      emit(TransportEvent::ALIVE, clientId);
+    } else {
+      emit(TransportEvent::DATA, clientId, frame.data, frame.len);
+    }
+  }
+}
+
+void EspNowTransport::ping(uint32_t clientId) {
+  // ESP-NOW has no control frames; blocks answer this with a pong message
+  static const char PING[] = "{\"type\":\"ping\"}";
+  send(clientId, (const uint8_t*)PING, sizeof(PING) - 1, SendPolicy::PRIORITY);
+}
+
+bool EspNowTransport::send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy /*policy*/) {
+  // Frames go straight to the radio, so there is no queue for the policy to act on
+  if (len > ESP_NOW_MAX_DATA_LEN) return false;
+
+  uint8_t mac[6];
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    Peer* peer = findPeer(clientId);
+    if (!peer) return false;
+    memcpy(mac, peer->mac, 6);
+  }
+
+  return esp_now_send(mac, data, len) == ESP_OK;
+}
@@ -0,0 +1,56 @@
+#ifndef ESPNOW_TRANSPORT_H
+#define ESPNOW_TRANSPORT_H
+
+#include <Arduino.h>
+#include <esp_now.h>
+#include <vector>
+#include <mutex>
+#include "Transport.h"
+
+// Client ids handed out to ESP-NOW peers; AsyncWebSocket ids count up from 1 so they never collide
+#ifndef ESPNOW_CLIENT_ID_BASE
+#define ESPNOW_CLIENT_ID_BASE 0x80000000UL
+#endif
+
+/**
+ * Connectionless, low-latency link to blocks. A peer is registered the first time a block's
+ * frame arrives, so there is no station limit beyond ESP-NOW's own peer table.
+ * Frames are queued by the WiFi task and delivered from poll() in loop().
+ */
+class EspNowTransport : public Transport {
+private:
+  struct Peer {
+    uint8_t mac[6];
+    uint32_t id;
+  };
+
+  struct Frame {
+    uint8_t mac[6];
+    uint8_t len;
+    uint8_t data[ESP_NOW_MAX_DATA_LEN];
+  };
+
+  std::vector<Peer> m_peers;
+  std::mutex m_lock; // peers are added from loop() and looked up by send() on the WebSocket task too
+  QueueHandle_t m_rx_queue;
+
+  static EspNowTransport* s_instance;
+  static void onReceive(const esp_now_recv_info* info, const uint8_t* data, int len);
+
+  // Callers hold m_lock; the result is only valid until it is released
+  Peer* findPeer(const uint8_t* mac);
+  Peer* findPeer(uint32_t clientId);
+
+public:
+  EspNowTransport();
+
+  // Call after the softAP is up; blocks must use the same channel
+  bool begin();
+
+  bool send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy policy) override;
+  void ping(uint32_t clientId) override;
+  void poll() override;
+  const char* name() const override { return "espnow"; }
+};
+
+#endif // ESPNOW_TRANSPORT_H
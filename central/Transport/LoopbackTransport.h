@@ -0,0 +1,112 @@
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+// Header-only and free of Arduino headers so it builds on a host
+#include <stdint.h>
+#include <deque>
+#include <set>
+#include <vector>
+#include "Transport.h"
+
+/**
+ * In-memory transport. The remote side injects events with connect()/deliver()/disconnect(),
+ * which are handed to the central on the next poll(), and reads what the central sent with
+ * receive(). Each message carries the clock value it was queued at so a harness can measure
+ * end-to-end latency through the handlers. Pings are answered like a connected client would.
+ * Used by the host tests in test/host.
+ */
+class LoopbackTransport : public Transport {
+public:
+  using Clock = uint64_t (*)();
+
+  struct Message {
+    uint32_t clientId;
+    uint64_t queuedAt;
+    SendPolicy policy;
+    std::vector<uint8_t> data;
+  };
+
+private:
+  struct Inbound {
+    TransportEvent event;
+    Message message;
+  };
+
+  Clock m_clock;
+  bool m_authenticated;
+  std::set<uint32_t> m_answering; // clients that reply to pings
+  std::deque<Inbound> m_inbound;
+  std::deque<Message> m_outbound;
+
+  uint64_t now() const { return m_clock ? m_clock() : 0; }
+
+  void queue(TransportEvent event, uint32_t clientId, const uint8_t* data = nullptr, size_t len = 0) {
+    m_inbound.push_back({ event, { clientId, now(), SendPolicy::PRIORITY,
+                                   std::vector<uint8_t>(data, data + len) } });
+  }
+
+public:
+  // authenticated mirrors the WebSocket (true) or ESP-NOW (false) for the admin checks
+  explicit LoopbackTransport(Clock clock = nullptr, bool authenticated = true)
+    : m_clock(clock), m_authenticated(authenticated) {}
+
+  // Remote side
+  void connect(uint32_t clientId) {
+    m_answering.insert(clientId);
+    queue(TransportEvent::CONNECT, clientId);
+  }
+  void disconnect(uint32_t clientId) {
+    m_answering.erase(clientId);
+    queue(TransportEvent::DISCONNECT, clientId);
+  }
+  // Stay connected but stop answering pings, like a block that hung or lost power
+  void mute(uint32_t clientId) { m_answering.erase(clientId); }
+  void alive(uint32_t clientId) { queue(TransportEvent::ALIVE, clientId); }
+  void deliver(uint32_t clientId, const uint8_t* data, size_t len) {
+    queue(TransportEvent::DATA, clientId, data, len);
+  }
+
+  bool receive(Message& out) {
+    if (m_outbound.empty()) return false;
+    out = std::move(m_outbound.front());
+    m_outbound.pop_front();
+    return true;
+  }
+
+  size_t pendingInbound() const { return m_inbound.size(); }
+  size_t pendingOutbound() const { return m_outbound.size(); }
+
+  // Central side
+  bool send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy policy) override {
+    // A snapshot still waiting for the remote side is replaced rather than appended
+    if (policy == SendPolicy::LATEST_WINS) {
+      for (auto& m : m_outbound) {
+        if (m.clientId == clientId && m.policy == SendPolicy::LATEST_WINS) {
+          m.queuedAt = now();
+          m.data.assign(data, data + len);
+          return true;
+        }
+      }
+    }
+    m_outbound.push_back({ clientId, now(), policy, std::vector<uint8_t>(data, data + len) });
+    return true;
+  }
+
+  void ping(uint32_t clientId) override {
+    if (m_answering.count(clientId)) alive(clientId);
+  }
+
+  void poll() override {
+    while (!m_inbound.empty()) {
+      Inbound in = std::move(m_inbound.front());
+      m_inbound.pop_front();
+      const Message& m = in.message;
+      emit(in.event, m.clientId, m.data.data(), m.data.size());
+    }
+  }
+
+  bool isAuthenticated() const override { return m_authenticated; }
+  const char* name() const override { return "loopback"; }
+};
+
+#endif // LOOPBACK_TRANSPORT_H
@@ -0,0 +1,67 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+// Kept free of Arduino headers so LoopbackTransport builds on a host (see test/host)
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+enum class TransportEvent { CONNECT, DISCONNECT, DATA, ALIVE };
+
+// How a message may be treated when a client is not keeping up
+enum class SendPolicy {
+  PRIORITY,    // time-critical (rounds, sync): queued immediately, never replaced
+  LATEST_WINS  // snapshots: held back while the client's queue drains, newer ones replace it
+};
+
+// Per-client delivery counters
+struct TransportStats {
+  uint32_t sent;
+  uint32_t dropped;     // snapshots replaced before sending, or messages refused by a full queue
+  size_t queueDepth;    // messages waiting in the transport's outbound queue
+  size_t maxQueueDepth;
+};
+
+class Transport;
+
+// Called for every client event: connect, disconnect, an inbound message, or a liveness reply
+using TransportHandler = std::function<void(Transport& transport, TransportEvent event,
+                                            uint32_t clientId, const uint8_t* data, size_t len)>;
+
+/**
+ * A way for clients to reach the central. Each backend owns a range of client ids
+ * so clients from different transports can share Game's client list.
+ */
+class Transport {
+protected:
+  TransportHandler m_handler;
+
+  void emit(TransportEvent event, uint32_t clientId, const uint8_t* data = nullptr, size_t len = 0) {
+    if (m_handler) m_handler(*this, event, clientId, data, len);
+  }
+
+public:
+  virtual ~Transport() {}
+
+  void onEvent(TransportHandler handler) { m_handler = handler; }
+
+  // Send a message to one client; returns false if it could not be queued
+  virtual bool send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy policy) = 0;
+
+  // Delivery counters for a client, if the backend tracks them
+  virtual bool getStats(uint32_t /*clientId*/, TransportStats& /*out*/) { return false; }
+
+  // Ask a client to prove it is alive; the answer arrives as ALIVE
+  virtual void ping(uint32_t /*clientId*/) {}
+
+  // Deliver queued inbound events; called from loop()
+  virtual void poll() {}
+
+  // Whether clients had to prove they know the AP password to get here; only they may administer the game
+  virtual bool isAuthenticated() const { return false; }
+
+  // Human-readable backend name for logging
+  virtual const char* name() const = 0;
+};
+
+#endif // TRANSPORT_H
@@ -0,0 +1,98 @@
+#include "WebSocketTransport.h"
+
+WebSocketTransport::WebSocketTransport(AsyncWebSocket& ws) : m_ws(ws) {
+  m_ws.onEvent([this](AsyncWebSocket* /*server*/, AsyncWebSocketClient* client, AwsEventType type,
+                      void* /*arg*/, uint8_t* data, size_t len) {
+    if (!client) return;
+
+    switch (type) {
+      case WS_EVT_CONNECT:
+        emit(TransportEvent::CONNECT, client->id());
+        break;
+
+      case WS_EVT_DISCONNECT:
+        forget(client->id());
+        emit(TransportEvent::DISCONNECT, client->id());
+        break;
+
+      case WS_EVT_DATA:
+        emit(TransportEvent::DATA, client->id(), data, len);
+        break;
+
+      case WS_EVT_PONG:
+        emit(TransportEvent::ALIVE, client->id());
+        break;
+
+      default:
+        // Errors are handled by the library
+        break;
+    }
+  });
+}
+
+void WebSocketTransport::forget(uint32_t clientId) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  m_state.erase(clientId);
+}
+
+bool WebSocketTransport::send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy policy) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  AsyncWebSocketClient* client = m_ws.client(clientId);
+  if (!client) return false;
+
+  ClientState& st = m_state[clientId];
+  st.stats.queueDepth = client->queueLen();
+  st.stats.maxQueueDepth = max(st.stats.maxQueueDepth, st.stats.queueDepth);
+
+  // Don't pile stale snapshots behind each other; keep only the newest until the queue drains
+  if (policy == SendPolicy::LATEST_WINS && (st.hasPending || st.stats.queueDepth > 0)) {
+    if (st.hasPending) st.stats.dropped++;
+    st.pending = String((const char*)data, len);
+    st.hasPending = true;
+    return true;
+  }
+
+  if (client->queueIsFull()) {
+    st.stats.dropped++;
+    return false;
+  }
+  client->text(data, len);
+  st.stats.sent++;
+  return true;
+}
+
+void WebSocketTransport::ping(uint32_t clientId) {
+  // Control frame; the block's WebSocket library answers with a pong on its own
+  AsyncWebSocketClient* client = m_ws.client(clientId);
+  if (client) client->ping();
+}
+
+void WebSocketTransport::poll() {
+  std::lock_guard<std::mutex> guard(m_lock);
+  for (auto& entry : m_state) {
+    ClientState& st = entry.second;
+    if (!st.hasPending) continue;
+
+    AsyncWebSocketClient* client = m_ws.client(entry.first);
+    if (!client) {
+      st.hasPending = false;
+      continue;
+    }
+
+    st.stats.queueDepth = client->queueLen();
+    if (st.stats.queueDepth > 0) continue;
+
+    client->text(st.pending);
+    st.pending = String();
+    st.hasPending = false;
+    st.stats.sent++;
+  }
+}
+
+bool WebSocketTransport::getStats(uint32_t clientId, TransportStats& out) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  auto it = m_state.find(clientId);
+  if (it == m_state.end()) return false;
+  out = it->second.stats;
+  return true;
+}
@@ -0,0 +1,35 @@
+#ifndef WEBSOCKET_TRANSPORT_H
+#define WEBSOCKET_TRANSPORT_H
+
+#include <ESPAsyncWebServer.h>
+#include <map>
+#include <mutex>
+#include "Transport.h"
+
+// Web clients and blocks connected over the softAP WebSocket
+class WebSocketTransport : public Transport {
+private:
+  struct ClientState {
+    String pending;       // latest snapshot held back until the client's queue drains
+    bool hasPending = false;
+    TransportStats stats = {};
+  };
+
+  AsyncWebSocket& m_ws;
+  std::map<uint32_t, ClientState> m_state;
+  std::mutex m_lock; // send() runs from both the WebSocket task and loop()
+
+  void forget(uint32_t clientId);
+
+public:
+  WebSocketTransport(AsyncWebSocket& ws);
+
+  bool send(uint32_t clientId, const uint8_t* data, size_t len, SendPolicy policy) override;
+  void ping(uint32_t clientId) override;
+  void poll() override;
+  bool getStats(uint32_t clientId, TransportStats& out) override;
+  bool isAuthenticated() const override { return true; } // only reachable after joining the WPA2 softAP
+  const char* name() const override { return "websocket"; }
+};
+
+#endif // WEBSOCKET_TRANSPORT_H
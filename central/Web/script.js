@@ -1,6 +1,10 @@
 const ws = new WebSocket(`ws://${window.location.host}/ws`);
 const state = { phase:'LOBBY', round:0, currentCmd:'', players:[] };
 
+// Table rows keyed by blockId so updates only touch cells that changed
+const rows = new Map();
+let renderQueued = false;
+
 // Cache for selected voice
 let selectedVoice = null;
 
@@ -75,7 +79,7 @@ ws.onmessage = (ev) => {
         speakCommand(state.currentCmd);
       }
       
-      render();
+      scheduleRender();
     }
   } catch(e) {}
 };
@@ -107,6 +111,66 @@ function renameBlock(bid, name){
   sendAdmin({action:'rename', blockId:bid, name});
 }
 
+// Coalesce bursts of state messages into one render per frame
+function scheduleRender() {
+  if (renderQueued) return;
+  renderQueued = true;
+  requestAnimationFrame(() => {
+    renderQueued = false;
+    render();
+  });
+}
+
+function setText(el, text) {
+  if (el.textContent !== text) el.textContent = text;
+}
+
+function setBadge(el, ok, badClass, okText, badText) {
+  const cls = `badge ${ok ? 'ok' : badClass}`;
+  if (el.className !== cls) el.className = cls;
+  setText(el, ok ? okText : badText);
+}
+
+function createRow(blockId) {
+  const tr = document.createElement('tr');
+  const cells = [];
+  for (let i = 0; i < 8; i++) {
+    cells.push(tr.appendChild(document.createElement('td')));
+  }
+  const badges = {};
+  for (const [key, idx] of [['inGame', 2], ['connected', 4], ['reported', 5], ['successful', 6]]) {
+    badges[key] = cells[idx].appendChild(document.createElement('span'));
+  }
+
+  // Rename controls are created once so typing isn't interrupted by state updates
+  const input = document.createElement('input');
+  input.size = 10;
+  const button = document.createElement('button');
+  button.textContent = 'Save';
+  button.onclick = () => renameBlock(blockId, input.value);
+  cells[7].append(input, ' ', button);
+
+  setText(cells[1], blockId);
+  return { tr, cells, badges, input, button, name: null };
+}
+
+function updateRow(row, p, isLobby) {
+  setText(row.cells[0], p.name);
+  setText(row.cells[3], String(p.score));
+  setBadge(row.badges.inGame, p.inGame, 'out', 'IN', 'OUT');
+  setBadge(row.badges.connected, p.connected, 'disc', 'ON', 'OFF');
+  setBadge(row.badges.reported, p.reported, 'out', 'YES', 'NO');
+  setBadge(row.badges.successful, p.successful, 'out', 'YES', 'NO');
+
+  // Only refresh the input when the server name changed and the user isn't editing it
+  if (row.name !== p.name) {
+    row.name = p.name;
+    if (document.activeElement !== row.input) row.input.value = p.name;
+  }
+  if (row.input.disabled === isLobby) row.input.disabled = !isLobby;
+  if (row.button.disabled === isLobby) row.button.disabled = !isLobby;
+}
+
 function render() {
   document.getElementById('phaseRound').textContent = `Phase: ${state.phase}`;
   document.getElementById('Round').textContent = `Round: ${state.round > 0 ? state.round : '-'}`;
@@ -125,28 +189,33 @@ function render() {
   document.getElementById('minms').disabled = !isLobby;
 
   const tb = document.querySelector('#table tbody');
-  tb.innerHTML = '';
+  const seen = new Set();
+  for (const p of state.players) {
+    let row = rows.get(p.blockId);
+    if (!row) {
+      row = createRow(p.blockId);
+      rows.set(p.blockId, row);
+    }
+    updateRow(row, p, isLobby);
+    seen.add(p.blockId);
+  }
+
+  for (const [blockId, row] of rows) {
+    if (!seen.has(blockId)) {
+      row.tr.remove();
+      rows.delete(blockId);
+    }
+  }
+
+  // Move rows only where the score order changed, so unchanged rows keep focus and layout
   const sorted = [...state.players].sort((a,b)=> b.score - a.score);
+  let cursor = tb.firstElementChild;
   for (const p of sorted) {
-    const tr = document.createElement('tr');
-    const inBadge = `<span class="badge ${p.inGame?'ok':'out'}">${p.inGame?'IN':'OUT'}</span>`;
-    const cBadge  = `<span class="badge ${p.connected?'ok':'disc'}">${p.connected?'ON':'OFF'}</span>`;
-    const reportedBadge = `<span class="badge ${p.reported?'ok':'out'}">${p.reported?'YES':'NO'}</span>`;
-    const successBadge = `<span class="badge ${p.successful?'ok':'out'}">${p.successful?'YES':'NO'}</span>`;
-
-    const disabledAttr = isLobby ? '' : 'disabled';
-    tr.innerHTML = `
-      <td>${p.name}</td>
-      <td>${p.blockId}</td>
-      <td>${inBadge}</td>
-      <td>${p.score}</td>
-      <td>${cBadge}</td>
-      <td>${reportedBadge}</td>
-      <td>${successBadge}</td>
-      <td>
-        <input size="10" value="${p.name}" id="name-${p.blockId}" ${disabledAttr}>
-        <button onclick="renameBlock('${p.blockId}', document.getElementById('name-${p.blockId}').value)" ${disabledAttr}>Save</button>
-      </td>`;
-    tb.appendChild(tr);
+    const tr = rows.get(p.blockId).tr;
+    if (tr === cursor) {
+      cursor = cursor.nextElementSibling;
+    } else {
+      tb.insertBefore(tr, cursor);
+    }
   }
 }
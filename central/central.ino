@@ -5,17 +5,36 @@
 #include <WiFi.h>
 #include <ESPAsyncWebServer.h>
 #include <Arduino_JSON.h>
+#include <LittleFS.h>
+#include <Preferences.h>
 #include <vector>
 #include "Web/web_interface.h"
 #include "Game/Game.h"
 #include "Player/Player.h"
+#include "Journal/Journal.h"
+#include "Liveness/LivenessWheel.h"
+#include "Transport/Transport.h"
+#include "Transport/WebSocketTransport.h"
+#include "Transport/EspNowTransport.h"
+#include "Protocol/Protocol.h"
 
 // Include implementations for Arduino IDE (since .cpp files in subdirs aren't auto-compiled)
 #include "Game/Game.cpp"
 #include "Player/Player.cpp"
+#include "Journal/Journal.cpp"
+#include "Liveness/LivenessWheel.cpp"
+#include "Transport/WebSocketTransport.cpp"
+#include "Transport/EspNowTransport.cpp"
+#include "Protocol/Protocol.cpp"
 
 // ======================== CONFIGURATION ========================
 
+// Accept blocks over ESP-NOW in addition to the WebSocket. ESP-NOW frames are not encrypted and
+// need no AP password, so anyone in radio range can pose as a block; only enable it when that's acceptable.
+#ifndef ENABLE_ESPNOW
+#define ENABLE_ESPNOW 0
+#endif
+
 // Hardware pins
 #ifndef WIFI_STATUS_LED
 #define WIFI_STATUS_LED 2
@@ -28,245 +47,97 @@ const uint8_t AP_CHANNEL = 6;
 const uint8_t AP_MAX_CONNECTIONS = 8;
 
 // Timing constants (milliseconds)
-const uint32_t SYNC_INTERVAL_MS = 1000;  // Time sync broadcast interval
-const uint32_t PRUNE_INTERVAL_MS = 2000; // Player connection check interval
-const uint32_t PLAYER_TIMEOUT_MS = 5000; // Player disconnect timeout
-const uint32_t ROUND_DELAY_MS = 800;     // Delay between rounds
-const uint32_t DEADLINE_GRACE_MS = 20;   // Grace period after round deadline
+const uint32_t JOURNAL_FLUSH_MS = 2000;  // Journal flush interval outside of rounds
+const size_t JOURNAL_ROTATE_BYTES = 64 * 1024; // Start a new journal file between games past this size
+const uint32_t CHECKPOINT_MS = 3000;     // Minimum interval between snapshot writes to NVS
+const uint32_t GAME_CHECKPOINT_MS = 10000; // Minimum interval between snapshot writes while rounds are being played
 
 // Other constants
 const uint16_t HTTP_STATUS_OK = 200;        // HTTP status code
 const uint16_t HTTP_STATUS_NOT_FOUND = 404; // HTTP status code
+const uint16_t HTTP_STATUS_CONFLICT = 409;  // HTTP status code
 const uint32_t BAUD_RATE = 115200;          // Serial communication baud rate
 const uint32_t SERIAL_INIT_DELAY_MS = 100;  // Allow serial to initialize
 const uint32_t STATUS_LIGHT_DELAY_MS = 100; // Default delay for status LED blink
+const char* JOURNAL_PATH = "/journal.bin";  // Journal file on flash
 
 // ======================== GLOBAL INSTANCES ========================
 
 AsyncWebServer server(80);
 AsyncWebSocket ws("/ws");
+WebSocketTransport wsTransport(ws);
+#if ENABLE_ESPNOW
+EspNowTransport espNowTransport;
+#endif
 Game* game = nullptr;
+Journal journal;
+Preferences prefs;
+std::vector<uint8_t> lastSnapshot; // Last snapshot written to NVS
 
-// ======================== WEBSOCKET MESSAGE HANDLERS ========================
-
-void handleBlockHello(AsyncWebSocketClient* client, JSONVar& doc) {
-  if (!client || !game) {
-    return;
-  }
-  
-  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
-  ClientMeta* meta = game->getClient(client->id());
-  if (!meta) {
-    return;
-  }
-  
-  meta->role = "block";
-  meta->blockId = blockId;
-
-  Player& player = game->addPlayer(blockId);
-  player.setConnected(true);
-  player.setLastSeenMs(millis());
-}
+// ======================== TRANSPORT EVENTS ========================
 
-void handleWebHello(AsyncWebSocketClient* client, JSONVar& doc) {
-  if (!client || !game) {
-    return;
-  }
-  
-  ClientMeta* meta = game->getClient(client->id());
-  if (!meta) {
-    return;
-  }
-  
-  meta->role = "web";
-  meta->blockId = ""; // Web clients don't have block IDs
-  
-  Serial.printf("Web client connected: %u\n", client->id());
-  
-  // Send current game state to the newly connected web client
-  game->broadcastStateToWeb(client->id());
-}
-
-void handleBlockStatus(JSONVar& doc) {
+void onTransportEvent(Transport& transport, TransportEvent event, uint32_t clientId, const uint8_t* data, size_t len) {
   if (!game) {
     return;
   }
-  
-  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
-  Player* player = game->getPlayer(blockId);
-  if (!player) {
-    return;
-  }
-  
-  player->setConnected(true);
-  player->setLastSeenMs(millis());
+  handleTransportEvent(*game, transport, event, clientId, data, len);
 }
 
-void handleBlockResult(JSONVar& doc) {
-  if (!game) {
-    return;
-  }
-  
-  // Only accept results during active game phases
-  Phase currentPhase = game->getPhase();
-  if (currentPhase != Phase::RUNNING && currentPhase != Phase::WAITING_NEXT_ROUND) {
-    return;
-  }
-
-  // Validate round number
-  int round = doc.hasOwnProperty("round") ? (int)doc["round"] : -999;
-  if (round != game->getRound()) {
-    return;
-  }
-  
-  // Validate block ID
-  String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
-  Player* player = game->getPlayer(blockId);
-  if (!player) {
-    return;
-  }
-  
-  if (!player->isInGame()) {
-    return;
-  }
+// ======================== HTTP SERVER SETUP ========================
 
-  // Process the result
-  bool actionDone = doc.hasOwnProperty("actionDone") ? (bool)doc["actionDone"] : false;
-  player->setReported(true);
-  player->setSuccess(actionDone);
-  
-  if (actionDone) {
-    player->incrementScore();
-  }
+// The current journal, or the one kept from before the last reset or rotation with ?old=1
+String journalPathFor(AsyncWebServerRequest* request) {
+  bool old = request->hasParam("old") && request->getParam("old")->value() == "1";
+  return old ? journal.getOldPath() : String(JOURNAL_PATH);
 }
 
-void handleAdmin(AsyncWebSocketClient* client, JSONVar& doc) {
-  if (!client || !game) {
-    return;
-  }
-  
-  // Verify client authentication
-  ClientMeta* meta = game->getClient(client->id());
-  if (!meta || meta->role != "web") {
-    return;
-  }
-  
-  String action = doc.hasOwnProperty("action") ? (const char*)doc["action"] : "";
-  if (action.isEmpty()) {
-    return;
-  }
+void setupHttp() {  
+  // Serve main web interface
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
+    request->send_P(HTTP_STATUS_OK, "text/html", INDEX_HTML);
+  });
 
-  // Process admin commands
-  if (action == "start") {
-    uint32_t round0Ms = doc.hasOwnProperty("round0Ms") ? (uint32_t)(int)doc["round0Ms"] : 2500;
-    uint32_t decayMs = doc.hasOwnProperty("decayMs") ? (uint32_t)(int)doc["decayMs"] : 150;
-    uint32_t minMs = doc.hasOwnProperty("minMs") ? (uint32_t)(int)doc["minMs"] : 800;
-    
-    game->startGame(round0Ms, decayMs, minMs);
-    
-  } else if (action == "pause") {
-    game->pauseGame();
-    
-  } else if (action == "resume") {
-    game->resumeGame();
-    
-  } else if (action == "reset") {
-    game->resetGame();
-    
-  } else if (action == "rename") {
-    String blockId = doc.hasOwnProperty("blockId") ? (const char*)doc["blockId"] : "";
-    String name = doc.hasOwnProperty("name") ? (const char*)doc["name"] : "";
-    
-    if (blockId.isEmpty() || name.isEmpty()) {
+  // Export the raw journal for offline inspection; ?old=1 selects the previous file
+  server.on("/journal", HTTP_GET, [](AsyncWebServerRequest* request) {
+    String path = journalPathFor(request);
+    if (!journal.getFs() || !LittleFS.exists(path)) {
+      request->send(HTTP_STATUS_NOT_FOUND, "text/plain", "Journal unavailable");
       return;
     }
-    
-    game->renamePlayer(blockId, name);
-    
-  } else {
-    // Unknown admin action
-  }
-}
-
-void onWsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    request->send(LittleFS, path, "application/octet-stream", true);
+  });
 
-  if (!game) {
-    return;
-  }
-  
-  switch (type) {
-    case WS_EVT_CONNECT:
-      game->addClient(client->id());
-      // Initial state will be sent after hello message
-      break;
-      
-    case WS_EVT_DISCONNECT:
-    {
-      // Handle block disconnection
-      ClientMeta* meta = game->getClient(client->id());
-      if (meta && meta->role == "block" && !meta->blockId.isEmpty()) {
-        Player* player = game->getPlayer(meta->blockId);
-        if (player) {
-          player->setConnected(false);
-        }
-      }
-      
-      game->removeClient(client->id());
-      break;
+  // Replay the journal and check it reproduces the recorded outcomes.
+  // Replay runs on the WebSocket task and stalls all traffic while it reads, so only between games.
+  server.on("/journal/replay", HTTP_GET, [](AsyncWebServerRequest* request) {
+    Phase phase = game->getPhase();
+    if (phase != Phase::LOBBY && phase != Phase::DONE) {
+      request->send(HTTP_STATUS_CONFLICT, "text/plain", "Replay is only available in LOBBY or DONE");
+      return;
     }
-      
-    case WS_EVT_DATA:
-    {
-      // Parse and validate JSON message
-      if (len == 0 || !data) {
-        return;
-      }
-      
-      String jsonString = String((char*)data).substring(0, len);
-      JSONVar doc = JSON.parse(jsonString);
-      
-      if (JSON.typeof(doc) == "undefined") {
-        return;
-      }
+    request->send(HTTP_STATUS_OK, "application/json", replayJournal(journal, journalPathFor(request)));
+  });
 
-      // Route message based on type
-      String msgType = doc.hasOwnProperty("type") ? (const char*)doc["type"] : "";
-      if (msgType.isEmpty()) {
-        return;
-      }
-      
-      if (msgType == "hello") {
-        handleBlockHello(client, doc);
-      } else if (msgType == "web-hello") {
-        handleWebHello(client, doc);
-      } else if (msgType == "status") {
-        handleBlockStatus(doc);
-      } else if (msgType == "result") {
-        handleBlockResult(doc);
-      } else if (msgType == "admin") {
-        handleAdmin(client, doc);
+  // Per-client delivery counters
+  server.on("/clients", HTTP_GET, [](AsyncWebServerRequest* request) {
+    JSONVar arr;
+    int i = 0;
+    for (const auto& c : game->getClients()) {
+      JSONVar obj;
+      obj["id"] = (double)c.id;
+      obj["role"] = c.role;
+      obj["blockId"] = c.blockId;
+      obj["transport"] = c.transport ? c.transport->name() : "none";
+      TransportStats stats;
+      if (c.transport && c.transport->getStats(c.id, stats)) {
+        obj["sent"] = (double)stats.sent;
+        obj["dropped"] = (double)stats.dropped;
+        obj["queueDepth"] = (int)stats.queueDepth;
+        obj["maxQueueDepth"] = (int)stats.maxQueueDepth;
       }
-      break;
+      arr[i++] = obj;
     }
-      
-    case WS_EVT_ERROR:
-      break;
-      
-    case WS_EVT_PONG:
-      break;
-      
-    default:
-      // Unknown WebSocket event type
-      break;
-  }
-}
-
-// ======================== HTTP SERVER SETUP ========================
-
-void setupHttp() {  
-  // Serve main web interface
-  server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send_P(HTTP_STATUS_OK, "text/html", INDEX_HTML);
+    request->send(HTTP_STATUS_OK, "application/json", JSON.stringify(arr));
   });
 
   // Add basic error handling
@@ -275,7 +146,7 @@ void setupHttp() {
   });
   
   // Configure WebSocket
-  ws.onEvent(onWsEvent);
+  wsTransport.onEvent(onTransportEvent);
   server.addHandler(&ws);
   
   // Start server
@@ -284,6 +155,12 @@ void setupHttp() {
 
 // ======================== HELPER FUNCTIONS ========================
 
+// Timing variables for main loop intervals
+uint32_t lastPingMs = 0;
+uint32_t lastJournalFlushMs = 0;
+uint32_t lastCheckpointMs = 0;
+Phase checkpointPhase = Phase::LOBBY; // phase at the last checkpoint
+
 bool setupWiFiAP() {  
   WiFi.mode(WIFI_AP);
   bool success = WiFi.softAP(AP_SSID, AP_PASS, AP_CHANNEL, 0, AP_MAX_CONNECTIONS);
@@ -298,64 +175,72 @@ bool setupWiFiAP() {
   return success;
 }
 
-void broadcastTimeSync() {
-  JSONVar syncMsg;
-  syncMsg["type"] = "sync";
-  syncMsg["serverTimeMs"] = (unsigned long)millis();
-  
-  String message = JSON.stringify(syncMsg);
-  ws.textAll(message);
-}
+// Returns false when the flush was deferred so the caller retries instead of waiting a full interval
+bool flushJournal() {
+  // Never touch flash while a round is being timed unless the ring buffer is about to overflow
+  bool nearlyFull = journal.pendingBytes() > (JOURNAL_RING_BYTES * 3) / 4;
+  Phase phase = game->getPhase();
+  if (phase == Phase::RUNNING && !nearlyFull) {
+    return false;
+  }
+  journal.flush();
 
-void pruneDisconnectedPlayers() {
-  uint32_t currentTime = millis();
-  
-  for (const auto& player : game->getPlayers()) {
-    if (player->isConnected() && 
-        (currentTime - player->getLastSeenMs() > PLAYER_TIMEOUT_MS)) {
-      Serial.printf("Player timeout: %s (last seen %lu ms ago)\n", 
-                    player->getBlockId().c_str(), 
-                    currentTime - player->getLastSeenMs());
-      player->setConnected(false);
+  // Rotate between games so the new file starts from a checkpoint replay can build on
+  if (journal.fileBytes() > JOURNAL_ROTATE_BYTES && (phase == Phase::LOBBY || phase == Phase::DONE)) {
+    if (journal.rotate()) {
+      game->journalCheckpoint();
     }
   }
+
+  static uint32_t reportedDropped = 0;
+  if (journal.droppedBytes() != reportedDropped) {
+    Serial.printf("WARNING: Journal dropped %u bytes (%u total)\n",
+                  (unsigned)(journal.droppedBytes() - reportedDropped),
+                  (unsigned)journal.droppedBytes());
+    reportedDropped = journal.droppedBytes();
+  }
+  return true;
 }
 
-void processRoundTiming() {
-  Phase currentPhase = game->getPhase();
-  uint32_t currentTime = millis();
-  
-  // Check for round end during active gameplay
-  if (currentPhase == Phase::RUNNING) {
-    if (currentTime > game->getDeadlineMs() + DEADLINE_GRACE_MS) {
-      game->endRound();
-      
-      // Schedule next round
-      game->setRoundStartMs(currentTime + ROUND_DELAY_MS);
-      game->setPhase(Phase::WAITING_NEXT_ROUND);
+void restoreGameSnapshot() {
+  prefs.begin("central");
+  size_t len = prefs.getBytesLength("snapshot");
+  if (len > 0) {
+    std::vector<uint8_t> blob(len);
+    prefs.getBytes("snapshot", blob.data(), len);
+    if (game->restoreSnapshot(blob.data(), len)) {
+      lastSnapshot = blob;
+      Serial.printf("Restored game: phase %s, round %d, %u players\n",
+                    Game::phaseToStr(game->getPhase()).c_str(), game->getRound(),
+                    (unsigned)game->getPlayers().size());
     }
   }
-  
-  // Handle scheduled next round start
-  else if (currentPhase == Phase::WAITING_NEXT_ROUND) {
-    if (currentTime >= game->getRoundStartMs()) {
-      if (game->isPauseQueued()) {
-        game->setPauseQueued(false);
-        game->setPhase(Phase::PAUSED);
-      } else {
-        game->setPhase(Phase::RUNNING);
-        game->nextRound();
-      }
-    }
+  prefs.end();
+}
+
+// Returns false when the checkpoint was deferred so the caller retries instead of waiting a full interval
+bool checkpointGame() {
+  // Flash writes stall the CPU, so never checkpoint while a round is being timed
+  if (game->getPhase() == Phase::RUNNING) {
+    return false;
   }
+
+  // Only write when something worth resuming has changed to limit NVS wear
+  std::vector<uint8_t> snapshot = game->buildSnapshot();
+  if (snapshot == lastSnapshot) {
+    return true;
+  }
+
+  prefs.begin("central");
+  if (prefs.putBytes("snapshot", snapshot.data(), snapshot.size()) == snapshot.size()) {
+    lastSnapshot = std::move(snapshot);
+  }
+  prefs.end();
+  return true;
 }
 
 // ======================== MAIN SETUP & LOOP ========================
 
-// Timing variables for main loop intervals
-uint32_t lastSyncMs = 0;
-uint32_t lastPruneMs = 0;
-
 void setup() {
   // Initialize status LED (will be turned on when WiFi AP is ready)
   pinMode(WIFI_STATUS_LED, OUTPUT);
@@ -366,7 +251,7 @@ void setup() {
   delay(SERIAL_INIT_DELAY_MS); // Allow serial to initialize
 
   // Initialize game instance
-  game = new Game(&ws);
+  game = new Game();
   if (!game) {
     Serial.println("FATAL ERROR: Failed to create game instance");
     while (true) {
@@ -377,6 +262,15 @@ void setup() {
     }
   }
 
+  // Start the event journal (the game still runs if flash is unavailable)
+  if (!LittleFS.begin(true) || !journal.begin(LittleFS, JOURNAL_PATH)) {
+    Serial.println("WARNING: Journal storage unavailable");
+  }
+  game->setJournal(&journal);
+
+  // Resume a game interrupted by a reset or brown-out
+  restoreGameSnapshot();
+
   // Setup WiFi Access Point
   if (!setupWiFiAP()) {
     delete game;
@@ -390,31 +284,62 @@ void setup() {
 
   // Setup HTTP server and WebSocket
   setupHttp();
+
+#if ENABLE_ESPNOW
+  // Blocks can also reach us over ESP-NOW on the softAP channel
+  if (espNowTransport.begin()) {
+    espNowTransport.onEvent(onTransportEvent);
+  } else {
+    Serial.println("WARNING: ESP-NOW unavailable, blocks must use the WebSocket");
+  }
+#endif
 }
 
 void loop() {
+  // 0) Service transports: held-back state snapshots out, ESP-NOW frames in
+  wsTransport.poll();
+#if ENABLE_ESPNOW
+  espNowTransport.poll();
+#endif
+
   uint32_t currentTime = millis();
   
-  // 1) Broadcast time synchronization to all clients
-  if (currentTime - lastSyncMs >= SYNC_INTERVAL_MS) {
-    lastSyncMs = currentTime;
-    broadcastTimeSync();
+  // 1) Ping blocks and keep their clocks in sync
+  if (currentTime - lastPingMs >= PING_INTERVAL_MS) {
+    lastPingMs = currentTime;
+    pingBlocks(*game);
+    game->refreshTimeSync(SYNC_REFRESH_MS);
   }
 
-  // 2) Check for disconnected players and update their status
-  currentTime = millis();
-  if (currentTime - lastPruneMs >= PRUNE_INTERVAL_MS) {
-    lastPruneMs = currentTime;
-    pruneDisconnectedPlayers();
-  }
+  // 2) Disconnect players whose last-seen bucket has aged out
+  game->expireIdlePlayers(PLAYER_TIMEOUT_MS);
 
   // 3) Handle game round timing (only check frequently during active phases)
   Phase currentPhase = game->getPhase();
   if ((currentPhase == Phase::RUNNING || currentPhase == Phase::WAITING_NEXT_ROUND)) {
-    processRoundTiming();
+    processRoundTiming(*game);
+  }
+
+  // 4) Flush journal entries to flash in batches. Deferred flushes and checkpoints don't
+  //    advance their timers, so both retry on every pass and land in the gap between rounds.
+  currentTime = millis();
+  if (currentTime - lastJournalFlushMs >= JOURNAL_FLUSH_MS && flushJournal()) {
+    lastJournalFlushMs = currentTime;
+  }
+
+  // 5) Checkpoint game state to NVS: right away when a game pauses or ends, batched otherwise
+  //    (scores change every round, so mid-game writes are spaced further apart)
+  currentTime = millis();
+  currentPhase = game->getPhase();
+  bool settled = currentPhase != checkpointPhase &&
+                 (currentPhase == Phase::PAUSED || currentPhase == Phase::DONE);
+  uint32_t checkpointInterval = currentPhase == Phase::WAITING_NEXT_ROUND ? GAME_CHECKPOINT_MS : CHECKPOINT_MS;
+  if ((settled || currentTime - lastCheckpointMs >= checkpointInterval) && checkpointGame()) {
+    lastCheckpointMs = currentTime;
+    checkpointPhase = currentPhase;
   }
 
-  // 4) Clean up disconnected WebSocket clients
+  // 6) Clean up disconnected WebSocket clients
   ws.cleanupClients();
   
   // Small delay to prevent overwhelming the system
@@ -0,0 +1,162 @@
+#include "Harness.h"
+#include <chrono>
+
+static const char* JOURNAL_PATH = "/journal.bin";
+
+uint64_t wallUs() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void LatencyStats::add(uint64_t us) {
+  count++;
+  totalUs += us;
+  minUs = min(minUs, us);
+  maxUs = max(maxUs, us);
+}
+
+static String messageType(const uint8_t* data, size_t len) {
+  JSONVar doc = JSON.parse(String((const char*)data, len));
+  if (JSON.typeof(doc) == "undefined" || !doc.hasOwnProperty("type")) {
+    return "?";
+  }
+  return (const char*)doc["type"];
+}
+
+Harness::Harness() : web(wallUs, true), radio(wallUs, false) {
+  auto handler = [this](Transport& transport, TransportEvent event, uint32_t clientId,
+                        const uint8_t* data, size_t len) {
+    handleTransportEvent(game, transport, event, clientId, data, len);
+  };
+  web.onEvent(handler);
+  radio.onEvent(handler);
+
+  journal.begin(m_fs, JOURNAL_PATH);
+  game.setJournal(&journal);
+  m_lastPingMs = millis();
+}
+
+// ======================== REMOTE SIDE ========================
+
+void Harness::addBlock(LoopbackTransport& link, uint32_t clientId, const String& blockId,
+                        uint32_t reactionMs, int missRound) {
+  link.connect(clientId);
+  send(link, clientId, "{\"type\":\"hello\",\"blockId\":\"" + blockId + "\"}");
+  m_blocks.push_back({ &link, clientId, blockId, reactionMs, missRound });
+}
+
+void Harness::addDashboard(LoopbackTransport& link, uint32_t clientId) {
+  link.connect(clientId);
+  send(link, clientId, "{\"type\":\"web-hello\"}");
+}
+
+void Harness::send(LoopbackTransport& link, uint32_t clientId, const String& json) {
+  // Handled on the spot so the measurement covers parsing, the handler and the journal only
+  uint64_t start = wallUs();
+  link.deliver(clientId, (const uint8_t*)json.c_str(), json.length());
+  link.poll();
+  m_latency["in:" + messageType((const uint8_t*)json.c_str(), json.length())].add(wallUs() - start);
+}
+
+void Harness::play(FakeBlock& block) {
+  if (block.reported || block.round == 0) {
+    return;
+  }
+
+  uint64_t now = esp_timer_get_time();
+  bool missing = block.round == block.missRound;
+  uint64_t actionUs = block.roundStartUs + (uint64_t)block.reactionMs * 1000;
+  if (missing ? now < block.deadlineUs : now < actionUs) {
+    return;
+  }
+
+  block.reported = true;
+  String result = "{\"type\":\"result\",\"blockId\":\"" + block.blockId + "\",\"round\":" +
+                  String(block.round) + ",\"actionDone\":" + (missing ? "false" : "true");
+  if (!missing) {
+    result += ",\"actionUs\":" + String((double)actionUs, 0);
+  }
+  result += "}";
+  send(*block.link, block.clientId, result);
+}
+
+// Hand what the central sent to the fake clients
+void Harness::pump(LoopbackTransport& link) {
+  LoopbackTransport::Message m;
+  while (link.receive(m)) {
+    JSONVar doc = JSON.parse(String((const char*)m.data.data(), m.data.size()));
+    String type = JSON.typeof(doc) == "undefined" ? "?" : (const char*)doc["type"];
+    m_latency["out:" + type].add(wallUs() - m.queuedAt);
+
+    if (type == "state") {
+      m_stateMessages++;
+      continue;
+    }
+    if (type != "round") {
+      continue;
+    }
+    for (auto& b : m_blocks) {
+      if (b.link == &link && b.clientId == m.clientId) {
+        b.round = (int)doc["round"];
+        b.roundStartUs = (uint64_t)(double)doc["roundStartUs"];
+        b.deadlineUs = (uint64_t)(double)doc["deadlineUs"];
+        b.reported = false;
+      }
+    }
+  }
+}
+
+// ======================== CENTRAL LOOP ========================
+
+void Harness::step(uint32_t stepMs) {
+  // Same order as central.ino's loop()
+  web.poll();
+  radio.poll();
+
+  uint32_t currentTime = millis();
+  if (currentTime - m_lastPingMs >= PING_INTERVAL_MS) {
+    pingBlocks(game);
+    game.refreshTimeSync(SYNC_REFRESH_MS);
+    m_lastPingMs = currentTime;
+  }
+
+  game.expireIdlePlayers(PLAYER_TIMEOUT_MS);
+
+  Phase phase = game.getPhase();
+  if (phase == Phase::RUNNING || phase == Phase::WAITING_NEXT_ROUND) {
+    processRoundTiming(game);
+  }
+
+  journal.flush();
+
+  pump(web);
+  pump(radio);
+  for (auto& b : m_blocks) {
+    play(b);
+  }
+
+  host_clock_advance_us((int64_t)stepMs * 1000);
+}
+
+void Harness::run(uint32_t ms, uint32_t stepMs) {
+  for (uint32_t t = 0; t < ms; t += stepMs) {
+    step(stepMs);
+  }
+}
+
+bool Harness::runUntil(Phase phase, uint32_t limitMs) {
+  for (uint32_t t = 0; t < limitMs && game.getPhase() != phase; t++) {
+    step();
+  }
+  return game.getPhase() == phase;
+}
+
+void Harness::printLatency() const {
+  printf("  %-14s %8s %10s %10s %10s\n", "message", "count", "min us", "avg us", "max us");
+  for (const auto& kv : m_latency) {
+    const LatencyStats& s = kv.second;
+    printf("  %-14s %8u %10llu %10llu %10llu\n", kv.first.c_str(), s.count,
+           (unsigned long long)s.minUs, (unsigned long long)(s.totalUs / s.count),
+           (unsigned long long)s.maxUs);
+  }
+}
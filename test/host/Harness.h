@@ -0,0 +1,81 @@
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <Arduino.h>
+#include <Arduino_JSON.h>
+#include <FS.h>
+#include <map>
+#include <vector>
+#include "../../central/Game/Game.h"
+#include "../../central/Journal/Journal.h"
+#include "../../central/Protocol/Protocol.h"
+#include "../../central/Transport/LoopbackTransport.h"
+
+// Real elapsed time in microseconds, for latency; the game itself runs on the fake esp_timer clock
+uint64_t wallUs();
+
+// A block on the other end of a loopback link that plays rounds on its own
+struct FakeBlock {
+  LoopbackTransport* link;
+  uint32_t clientId;
+  String blockId;
+  uint32_t reactionMs; // how long after the round start it acts
+  int missRound;       // round it fails to act in (0 = never)
+
+  int round = 0;
+  uint64_t roundStartUs = 0;
+  uint64_t deadlineUs = 0;
+  bool reported = true;
+};
+
+struct LatencyStats {
+  uint32_t count = 0;
+  uint64_t totalUs = 0;
+  uint64_t minUs = UINT64_MAX;
+  uint64_t maxUs = 0;
+
+  void add(uint64_t us);
+};
+
+/**
+ * The central's loop() on a host: the same Game, Journal and protocol handlers, with the
+ * WebSocket replaced by a loopback link and ESP-NOW by an unauthenticated one. step() runs
+ * one loop iteration and advances the fake clock, so a whole game plays out in milliseconds.
+ */
+class Harness {
+private:
+  fs::FS m_fs;
+  std::vector<FakeBlock> m_blocks;
+  std::map<String, LatencyStats> m_latency;
+  uint32_t m_lastPingMs = 0;
+  uint32_t m_stateMessages = 0;
+
+  void pump(LoopbackTransport& link);
+  void play(FakeBlock& block);
+
+public:
+  Journal journal;
+  Game game;
+  LoopbackTransport web;   // stands in for the WebSocket (password-protected AP)
+  LoopbackTransport radio; // stands in for ESP-NOW (anyone in range)
+
+  Harness();
+
+  // Remote side
+  void addBlock(LoopbackTransport& link, uint32_t clientId, const String& blockId,
+                uint32_t reactionMs = 150, int missRound = 0);
+  void addDashboard(LoopbackTransport& link, uint32_t clientId);
+  void send(LoopbackTransport& link, uint32_t clientId, const String& json);
+
+  // One loop() iteration, then the clock moves stepMs forward
+  void step(uint32_t stepMs = 1);
+  void run(uint32_t ms, uint32_t stepMs = 1);
+  // Run until the game reaches a phase, giving up after limitMs; returns whether it did
+  bool runUntil(Phase phase, uint32_t limitMs);
+
+  uint32_t stateMessages() const { return m_stateMessages; }
+  String replay(const String& path) { return replayJournal(journal, path); }
+  void printLatency() const;
+};
+
+#endif // HARNESS_H
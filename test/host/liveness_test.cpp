@@ -0,0 +1,67 @@
+// Random touches against the LivenessWheel, checking every expiry lands inside
+// [timeout, timeout + one bucket) and that the bucket lists stay intact.
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include "../../central/Liveness/LivenessWheel.h"
+#include "../../central/Player/Player.h"
+
+static const uint64_t TIMEOUT_US = 5000 * 1000ULL;
+static const uint64_t BUCKET_US = LIVENESS_BUCKET_MS * 1000ULL;
+
+int main() {
+  int failures = 0;
+  LivenessWheel wheel;
+  std::vector<std::unique_ptr<Player>> players;
+  for (int i = 0; i < 64; i++) {
+    players.push_back(std::make_unique<Player>(String(i)));
+  }
+
+  // Start just below 2^32 us so the run crosses it
+  uint64_t now = (1ULL << 32) - 3000 * 1000ULL;
+  std::vector<uint64_t> quietUntil(players.size(), 0);
+  uint32_t expiredCount = 0;
+  for (int step = 0; step < 200000; step++) {
+    now += 1000 + esp_random() % 2000;
+
+    // Most players stay chatty; now and then one goes quiet for about the timeout
+    size_t i = esp_random() % players.size();
+    if (esp_random() % 64 == 0) {
+      quietUntil[i] = now + 4000 * 1000ULL + esp_random() % 3000000;
+    }
+    if (now >= quietUntil[i]) {
+      wheel.touch(players[i].get(), now);
+      players[i]->setConnected(true);
+    }
+
+    std::vector<Player*> expired;
+    wheel.expire(now, TIMEOUT_US, expired);
+    for (Player* e : expired) {
+      uint64_t idle = now - e->getLastSeenUs();
+      if (idle < TIMEOUT_US) {
+        printf("FAIL player %s expired after %llu us\n", e->getBlockId().c_str(), (unsigned long long)idle);
+        failures++;
+      }
+      e->setConnected(false);
+      expiredCount++;
+    }
+    for (auto& q : players) {
+      if (q->isConnected() && now - q->getLastSeenUs() >= TIMEOUT_US + BUCKET_US) {
+        printf("FAIL player %s missed, idle %llu us\n", q->getBlockId().c_str(),
+               (unsigned long long)(now - q->getLastSeenUs()));
+        failures++;
+        q->setConnected(false);
+      }
+    }
+  }
+
+  wheel.clear();
+  if (expiredCount == 0) {
+    printf("FAIL nothing expired\n");
+    failures++;
+  }
+  printf("%u expiries\n", expiredCount);
+  printf("%s\n", failures ? "liveness_test: FAILED" : "liveness_test: ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+// Plays a whole game through the central's protocol handlers over loopback links and checks
+// the outcome, the trust checks, idle expiry and journal replay, then prints handler latency.
+
+#include "Harness.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                  \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+static void checkPlayer(Game& game, const char* blockId, int score, bool inGame) {
+  Player* p = game.getPlayer(blockId);
+  CHECK(p != nullptr);
+  if (!p) return;
+  if (p->getScore() != score || p->isInGame() != inGame) {
+    printf("FAIL player %s: score %d inGame %d, expected %d %d\n", blockId, p->getScore(),
+           p->isInGame(), score, inGame);
+    failures++;
+  }
+}
+
+int main() {
+  Serial.quiet = true;
+  // Mid-bucket, so expiring a bucket that is only partly idle would show up as an early timeout
+  host_clock_set_us(10 * 1000000LL + 200000);
+
+  Harness h;
+  Game& game = h.game;
+
+  // Lobby: a dashboard, four blocks that miss rounds 6/4/2 or never, and one that goes silent
+  h.addDashboard(h.web, 1);
+  h.addBlock(h.web, 10, "A", 120);
+  h.addBlock(h.web, 11, "B", 200, 6);
+  h.addBlock(h.web, 12, "C", 250, 4);
+  h.addBlock(h.web, 13, "D", 300, 2);
+  h.addBlock(h.web, 14, "F");
+  h.web.mute(14);
+
+  // Blocks that answer pings stay; the silent one is dropped after the full timeout, within a bucket
+  h.run(PLAYER_TIMEOUT_MS);
+  CHECK(game.getPlayer("F")->isConnected());
+  h.run(LIVENESS_BUCKET_MS);
+  CHECK(!game.getPlayer("F")->isConnected());
+  CHECK(game.getPlayer("A")->isConnected());
+  CHECK(game.getPlayer("D")->isConnected());
+  CHECK(h.stateMessages() > 0);
+
+  h.send(h.web, 1, "{\"type\":\"admin\",\"action\":\"start\",\"round0Ms\":1000,\"decayMs\":50,\"minMs\":600}");
+  CHECK(game.getPhase() == Phase::RUNNING);
+  CHECK(!game.getPlayer("F")->isInGame());
+
+  // An ESP-NOW client may play but not administer, and may not answer for another block
+  h.radio.connect(1000);
+  h.send(h.radio, 1000, "{\"type\":\"web-hello\"}");
+  h.send(h.radio, 1000, "{\"type\":\"admin\",\"action\":\"pause\"}");
+  CHECK(!game.isPauseQueued());
+  h.run(700); // rounds start 500 ms after they are sent; A has reported round 1 by now
+  CHECK(game.getPlayer("A")->hasReported());
+  h.send(h.radio, 1000, "{\"type\":\"result\",\"blockId\":\"A\",\"round\":1,\"actionDone\":false}");
+  CHECK(game.getPlayer("A")->wasSuccessful());
+
+  CHECK(h.runUntil(Phase::DONE, 60000));
+  CHECK(game.getRound() == 6);
+  checkPlayer(game, "A", 6, true);
+  checkPlayer(game, "B", 5, false);
+  checkPlayer(game, "C", 3, false);
+  checkPlayer(game, "D", 1, false);
+
+  // The journal reproduces every round outcome
+  h.journal.flush();
+  JSONVar report = JSON.parse(h.replay("/journal.bin"));
+  CHECK((bool)report["ok"]);
+  CHECK((int)report["rounds"] == 6);
+
+  // An entry whose length runs past the end is reported instead of replayed
+  fs::File f = h.journal.getFs()->open("/journal.bin", FILE_APPEND);
+  const uint8_t bogus[Journal::HEADER_BYTES] = { 0, 0, 0, 0, 0, 0, 0, 0, 3, 0x88, 0x13 };
+  f.write(bogus, sizeof(bogus));
+  f.close();
+  report = JSON.parse(h.replay("/journal.bin"));
+  CHECK(!(bool)report["ok"]);
+  CHECK(report.hasOwnProperty("malformedEntry"));
+
+  printf("Handler latency (wall clock):\n");
+  h.printLatency();
+
+  printf("%s\n", failures ? "protocol_test: FAILED" : "protocol_test: ok");
+  return failures ? 1 : 0;
+}
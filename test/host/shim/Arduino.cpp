@@ -0,0 +1,26 @@
+#include "Arduino.h"
+
+HostSerial Serial;
+
+static int64_t s_clock_us = 0;
+
+int64_t esp_timer_get_time() {
+  return s_clock_us;
+}
+
+void host_clock_set_us(int64_t us) {
+  s_clock_us = us;
+}
+
+void host_clock_advance_us(int64_t us) {
+  s_clock_us += us;
+}
+
+uint32_t esp_random() {
+  // Deterministic so a failing run can be repeated
+  static uint32_t state = 0x12345678;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
@@ -0,0 +1,156 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Just enough of the Arduino core for the central's game code and Arduino_JSON to build on a host.
+// Time comes from the fake esp_timer clock (see esp_timer.h), so millis() wraps like the real one.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include "esp_timer.h"
+
+using std::min;
+using std::max;
+using std::nullptr_t;
+
+// ===== String =====
+
+class String {
+private:
+  std::string m_str;
+
+public:
+  String() {}
+  String(const char* cstr) : m_str(cstr ? cstr : "") {}
+  String(const char* cstr, unsigned int length) : m_str(cstr ? std::string(cstr, length) : "") {}
+  String(const std::string& str) : m_str(str) {}
+  String(char c) : m_str(1, c) {}
+  String(int value) : m_str(std::to_string(value)) {}
+  String(unsigned int value) : m_str(std::to_string(value)) {}
+  String(long value) : m_str(std::to_string(value)) {}
+  String(unsigned long value) : m_str(std::to_string(value)) {}
+  String(double value, unsigned int decimals = 2) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, value);
+    m_str = buf;
+  }
+
+  unsigned int length() const { return m_str.length(); }
+  bool isEmpty() const { return m_str.empty(); }
+  const char* c_str() const { return m_str.c_str(); }
+  char operator[](unsigned int index) const { return index < m_str.length() ? m_str[index] : 0; }
+
+  bool equals(const String& other) const { return m_str == other.m_str; }
+  bool operator==(const String& other) const { return m_str == other.m_str; }
+  bool operator==(const char* other) const { return m_str == (other ? other : ""); }
+  bool operator!=(const String& other) const { return !(*this == other); }
+  bool operator!=(const char* other) const { return !(*this == other); }
+  bool operator<(const String& other) const { return m_str < other.m_str; }
+
+  String& operator+=(const String& other) { m_str += other.m_str; return *this; }
+  String& operator+=(const char* other) { if (other) m_str += other; return *this; }
+  String& operator+=(char c) { m_str += c; return *this; }
+  bool concat(const String& other) { m_str += other.m_str; return true; }
+  bool concat(const char* other) { if (other) m_str += other; return true; }
+  bool concat(char c) { m_str += c; return true; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.m_str + b.m_str); }
+  friend String operator+(const String& a, const char* b) { return String(a.m_str + (b ? b : "")); }
+  friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.m_str); }
+
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t i = m_str.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  int indexOf(const String& s, unsigned int from = 0) const {
+    size_t i = m_str.find(s.m_str, from);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  String substring(unsigned int from) const { return from < m_str.length() ? String(m_str.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    return from < m_str.length() ? String(m_str.substr(from, to - from)) : String();
+  }
+  bool startsWith(const String& prefix) const { return m_str.compare(0, prefix.m_str.length(), prefix.m_str) == 0; }
+  long toInt() const { return strtol(m_str.c_str(), nullptr, 10); }
+  double toDouble() const { return strtod(m_str.c_str(), nullptr); }
+};
+
+// ===== Print / Serial =====
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+  size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+  size_t print(const char* str) { return write(str); }
+  size_t print(const String& str) { return write(str.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int value) { return print(String(value)); }
+  size_t print(unsigned int value) { return print(String(value)); }
+  size_t print(long value) { return print(String(value)); }
+  size_t print(unsigned long value) { return print(String(value)); }
+  size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+
+  size_t println() { return write("\n"); }
+  template <typename T> size_t println(const T& value) { return print(value) + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    return write((const uint8_t*)buf, min((size_t)n, sizeof(buf) - 1));
+  }
+};
+
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class HostSerial : public Print {
+public:
+  bool quiet = false; // tests silence the game's log lines when they only want their own output
+
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return quiet ? 1 : (size_t)fputc(c, stdout) != (size_t)EOF; }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    return quiet ? size : fwrite(buffer, 1, size, stdout);
+  }
+  using Print::write;
+};
+
+extern HostSerial Serial;
+
+// ===== Time, randomness, critical sections =====
+
+inline unsigned long millis() { return (unsigned long)(uint32_t)(esp_timer_get_time() / 1000); }
+inline unsigned long micros() { return (unsigned long)(uint32_t)esp_timer_get_time(); }
+inline void delay(uint32_t ms) { host_clock_advance_us((int64_t)ms * 1000); }
+
+uint32_t esp_random();
+
+// Tests are single-threaded, so critical sections only need to compile
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+#endif // HOST_ARDUINO_H
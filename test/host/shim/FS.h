@@ -0,0 +1,82 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+// In-memory stand-in for the ESP32 FS API (the calls Journal and replay make on LittleFS)
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+using Blob = std::shared_ptr<std::vector<uint8_t>>;
+
+class File {
+private:
+  Blob m_data;
+  size_t m_pos = 0;
+  bool m_writable = false;
+
+public:
+  File() {}
+  File(Blob data, size_t pos, bool writable) : m_data(data), m_pos(pos), m_writable(writable) {}
+
+  explicit operator bool() const { return (bool)m_data; }
+
+  size_t read(uint8_t* buf, size_t size) {
+    if (!m_data || m_pos >= m_data->size()) return 0;
+    size_t n = min(size, m_data->size() - m_pos);
+    memcpy(buf, m_data->data() + m_pos, n);
+    m_pos += n;
+    return n;
+  }
+
+  size_t write(const uint8_t* buf, size_t size) {
+    if (!m_data || !m_writable) return 0;
+    m_data->insert(m_data->end(), buf, buf + size);
+    m_pos = m_data->size();
+    return size;
+  }
+
+  size_t size() const { return m_data ? m_data->size() : 0; }
+  void close() { m_data.reset(); }
+};
+
+class FS {
+private:
+  std::map<std::string, Blob> m_files;
+
+public:
+  File open(const String& path, const char* mode) {
+    std::string key = path.c_str();
+    if (strcmp(mode, FILE_READ) == 0) {
+      auto it = m_files.find(key);
+      return it == m_files.end() ? File() : File(it->second, 0, false);
+    }
+    Blob& blob = m_files[key];
+    if (!blob || strcmp(mode, FILE_WRITE) == 0) {
+      blob = std::make_shared<std::vector<uint8_t>>();
+    }
+    return File(blob, blob->size(), true);
+  }
+
+  bool exists(const String& path) const { return m_files.count(path.c_str()) != 0; }
+  bool remove(const String& path) { return m_files.erase(path.c_str()) != 0; }
+
+  bool rename(const String& from, const String& to) {
+    auto it = m_files.find(from.c_str());
+    if (it == m_files.end()) return false;
+    m_files[to.c_str()] = it->second;
+    m_files.erase(it);
+    return true;
+  }
+};
+
+} // namespace fs
+
+#endif // HOST_FS_H
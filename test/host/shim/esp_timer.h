@@ -0,0 +1,12 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+// Fake monotonic clock behind esp_timer_get_time(), millis() and everything built on them.
+// It only moves when a test advances it, so games can be started at any uptime.
+int64_t esp_timer_get_time();
+void host_clock_set_us(int64_t us);
+void host_clock_advance_us(int64_t us);
+
+#endif // HOST_ESP_TIMER_H
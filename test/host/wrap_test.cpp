@@ -0,0 +1,85 @@
+// Plays the same game with uptime crossing 2^32 us (where a 32-bit micros() wraps) and
+// 2^32 ms (where millis() wraps), and checks it ends exactly as it does early after boot.
+
+#include "Harness.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                  \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+struct Outcome {
+  int rounds;
+  int scores[4];
+  bool inGame[4];
+};
+
+static const char* BLOCKS[4] = { "A", "B", "C", "D" };
+
+// Starts 3 s before startUs, so the boundary falls inside the idle timeout and the first rounds
+static Outcome play(const char* label, int64_t startUs) {
+  printf("%s: starting at %lld us\n", label, (long long)startUs);
+  host_clock_set_us(startUs - 3000 * 1000LL);
+
+  Harness h;
+  h.addDashboard(h.web, 1);
+  h.addBlock(h.web, 10, "A", 120);
+  h.addBlock(h.web, 11, "B", 200, 6);
+  h.addBlock(h.web, 12, "C", 250, 4);
+  h.addBlock(h.web, 13, "D", 300, 2);
+  h.addBlock(h.web, 14, "F");
+  h.web.mute(14);
+
+  h.run(PLAYER_TIMEOUT_MS);
+  CHECK(h.game.getPlayer("F")->isConnected());
+  h.run(LIVENESS_BUCKET_MS + 1);
+  CHECK(!h.game.getPlayer("F")->isConnected());
+  CHECK(h.game.getPlayer("A")->isConnected());
+
+  h.send(h.web, 1, "{\"type\":\"admin\",\"action\":\"start\",\"round0Ms\":1000,\"decayMs\":50,\"minMs\":600}");
+  CHECK(h.runUntil(Phase::DONE, 60000));
+
+  Outcome o;
+  o.rounds = h.game.getRound();
+  for (int i = 0; i < 4; i++) {
+    Player* p = h.game.getPlayer(BLOCKS[i]);
+    o.scores[i] = p ? p->getScore() : -1;
+    o.inGame[i] = p && p->isInGame();
+  }
+
+  h.journal.flush();
+  JSONVar report = JSON.parse(h.replay("/journal.bin"));
+  CHECK((bool)report["ok"]);
+  CHECK((int)report["rounds"] == o.rounds);
+  return o;
+}
+
+static void compare(const char* label, const Outcome& got, const Outcome& want) {
+  bool same = got.rounds == want.rounds;
+  for (int i = 0; i < 4; i++) {
+    same = same && got.scores[i] == want.scores[i] && got.inGame[i] == want.inGame[i];
+  }
+  if (!same) {
+    printf("FAIL %s: %d rounds, scores %d %d %d %d; expected %d rounds, scores %d %d %d %d\n", label,
+           got.rounds, got.scores[0], got.scores[1], got.scores[2], got.scores[3], want.rounds,
+           want.scores[0], want.scores[1], want.scores[2], want.scores[3]);
+    failures++;
+  }
+}
+
+int main() {
+  Serial.quiet = true;
+
+  Outcome baseline = play("baseline", 10 * 1000000LL);
+  CHECK(baseline.rounds == 6);
+  compare("2^32 us", play("2^32 us", 1LL << 32), baseline);
+  compare("2^32 ms", play("2^32 ms", (1LL << 32) * 1000), baseline);
+
+  printf("%s\n", failures ? "wrap_test: FAILED" : "wrap_test: ok");
+  return failures ? 1 : 0;
+}